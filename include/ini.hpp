@@ -3,12 +3,62 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
+#include <charconv>
+#include <cstdint>
+#include <cstdlib>
 #include <cstring>
 #include <functional>
+#include <initializer_list>
+#include <iterator>
 #include <map>
+#include <memory>
+#include <ostream>
+#include <scoped_allocator>
+#include <set>
 #include <stdexcept>
 #include <string>
 #include <string_view>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <variant>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#  include <immintrin.h>
+#  define INI_SIMD_SSE2
+#elif defined(__aarch64__) && (defined(__ARM_NEON) || defined(__ARM_NEON__))
+#  include <arm_neon.h>
+#  define INI_SIMD_NEON
+#endif
+
+#include <filesystem>
+
+#if defined(_WIN32)
+#  pragma push_macro("WIN32_LEAN_AND_MEAN")
+#  pragma push_macro("NOMINMAX")
+#  ifndef WIN32_LEAN_AND_MEAN
+#    define WIN32_LEAN_AND_MEAN
+#  endif
+#  ifndef NOMINMAX
+#    define NOMINMAX
+#  endif
+#  include <Windows.h>
+#  pragma pop_macro("WIN32_LEAN_AND_MEAN")
+#  pragma pop_macro("NOMINMAX")
+#  define INI_MMAP_WINDOWS
+#elif defined(__unix__) || defined(__APPLE__)
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#  define INI_MMAP_POSIX
+#endif
+
+#if !defined(INI_MMAP_WINDOWS) && !defined(INI_MMAP_POSIX)
+#  include <fstream>
+#endif
 
 namespace ini
 {
@@ -24,6 +74,12 @@ namespace ini
         using range_error::range_error;
     };
 
+    class FileError final: public std::runtime_error
+    {
+    public:
+        using runtime_error::runtime_error;
+    };
+
     using Values = std::map<std::string, std::string, std::less<>>;
 
     inline namespace detail
@@ -47,6 +103,102 @@ namespace ini
             return c == ' ' || c == '\t';
         }
 
+        [[nodiscard]]
+        inline const char* findDelimiterScalar(const char* first, const char* const last,
+                                               const char c0, const char c1,
+                                               const char c2, const char c3) noexcept
+        {
+            while (first != last)
+            {
+                const auto c = *first;
+                if (c == c0 || c == c1 || c == c2 || c == c3)
+                    break;
+
+                ++first;
+            }
+
+            return first;
+        }
+
+#if defined(INI_SIMD_SSE2) && (defined(__GNUC__) || defined(__clang__))
+        __attribute__((target("avx2")))
+        [[nodiscard]]
+        inline const char* findDelimiterAvx2(const char* first, const char* const last,
+                                             const char c0, const char c1,
+                                             const char c2, const char c3) noexcept
+        {
+            const auto v0 = _mm256_set1_epi8(c0);
+            const auto v1 = _mm256_set1_epi8(c1);
+            const auto v2 = _mm256_set1_epi8(c2);
+            const auto v3 = _mm256_set1_epi8(c3);
+
+            for (; last - first >= 32; first += 32)
+            {
+                const auto chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first));
+                const auto hits = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(chunk, v0),
+                                                                  _mm256_cmpeq_epi8(chunk, v1)),
+                                                  _mm256_or_si256(_mm256_cmpeq_epi8(chunk, v2),
+                                                                  _mm256_cmpeq_epi8(chunk, v3)));
+
+                if (const auto mask = _mm256_movemask_epi8(hits); mask != 0)
+                    return first + __builtin_ctz(static_cast<unsigned int>(mask));
+            }
+
+            return findDelimiterScalar(first, last, c0, c1, c2, c3);
+        }
+#endif
+
+        // finds the first occurrence of any of the four bytes in [first, last)
+        [[nodiscard]]
+        inline const char* findDelimiter(const char* first, const char* const last,
+                                         const char c0, const char c1,
+                                         const char c2, const char c3) noexcept
+        {
+#if defined(INI_SIMD_SSE2)
+#  if defined(__GNUC__) || defined(__clang__)
+            static const bool hasAvx2 = __builtin_cpu_supports("avx2");
+            if (hasAvx2)
+                return findDelimiterAvx2(first, last, c0, c1, c2, c3);
+#  endif
+            const auto v0 = _mm_set1_epi8(c0);
+            const auto v1 = _mm_set1_epi8(c1);
+            const auto v2 = _mm_set1_epi8(c2);
+            const auto v3 = _mm_set1_epi8(c3);
+
+            for (; last - first >= 16; first += 16)
+            {
+                const auto chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+                const auto hits = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(chunk, v0),
+                                                            _mm_cmpeq_epi8(chunk, v1)),
+                                               _mm_or_si128(_mm_cmpeq_epi8(chunk, v2),
+                                                            _mm_cmpeq_epi8(chunk, v3)));
+
+                if (const auto mask = _mm_movemask_epi8(hits); mask != 0)
+                {
+                    auto offset = 0;
+                    while (!(mask & (1 << offset))) ++offset;
+                    return first + offset;
+                }
+            }
+#elif defined(INI_SIMD_NEON)
+            const auto v0 = vdupq_n_u8(static_cast<std::uint8_t>(c0));
+            const auto v1 = vdupq_n_u8(static_cast<std::uint8_t>(c1));
+            const auto v2 = vdupq_n_u8(static_cast<std::uint8_t>(c2));
+            const auto v3 = vdupq_n_u8(static_cast<std::uint8_t>(c3));
+
+            for (; last - first >= 16; first += 16)
+            {
+                const auto chunk = vld1q_u8(reinterpret_cast<const std::uint8_t*>(first));
+                const auto hits = vorrq_u8(vorrq_u8(vceqq_u8(chunk, v0), vceqq_u8(chunk, v1)),
+                                           vorrq_u8(vceqq_u8(chunk, v2), vceqq_u8(chunk, v3)));
+
+                if (vmaxvq_u8(hits) != 0)
+                    break;
+            }
+#endif
+            return findDelimiterScalar(first, last, c0, c1, c2, c3);
+        }
+
         inline std::string& leftTrim(std::string& s)
         {
             s.erase(s.begin(), std::find_if(s.begin(), s.end(),
@@ -65,18 +217,258 @@ namespace ini
         {
             return leftTrim(rightTrim(s));
         }
+
+        [[nodiscard]]
+        constexpr std::string_view trim(std::string_view s) noexcept
+        {
+            while (!s.empty() && isWhiteSpace(s.front())) s.remove_prefix(1);
+            while (!s.empty() && isWhiteSpace(s.back())) s.remove_suffix(1);
+            return s;
+        }
+
+        // advances the iterator past a comment and its terminating newline
+        inline void skipComment(const char*& iterator, const char* const end) noexcept
+        {
+            iterator = findDelimiter(iterator, end, '\r', '\n', '\r', '\n');
+            if (iterator != end)
+                ++iterator; // skip the newline
+        }
+
+        // detects containers backed by a contiguous byte buffer, those can
+        // take the pointer-based parse path and its vectorized scanning
+        template <class T, class = void>
+        struct HasContiguousByteData final: std::false_type {};
+
+        template <class T>
+        struct HasContiguousByteData<T, std::enable_if_t<
+            std::is_pointer_v<decltype(std::data(std::declval<const T&>()))> &&
+            sizeof(std::remove_pointer_t<decltype(std::data(std::declval<const T&>()))>) == 1>> final:
+            std::true_type {};
+
+        // a process-unique stamp; sections take a fresh one on every mutation,
+        // so two sections never share a version even across erase-and-recreate
+        // cycles. Each thread counts in its own slot with its ordinal in the
+        // high bits, so the hot mutation path never touches shared state -
+        // the process-wide atomic is hit once per thread, not once per write
+        [[nodiscard]] inline std::uint64_t nextVersion() noexcept
+        {
+            static std::atomic<std::uint64_t> threadCount{0};
+            thread_local const std::uint64_t threadBits =
+                threadCount.fetch_add(1, std::memory_order_relaxed) << 40U;
+            thread_local std::uint64_t counter = 0;
+            return threadBits | ++counter;
+        }
+
+        // FNV-1a, used to detect unchanged input spans between re-parses
+        [[nodiscard]]
+        constexpr std::uint64_t hashBytes(const char* first, const char* const last) noexcept
+        {
+            auto result = UINT64_C(0xcbf29ce484222325);
+            for (; first != last; ++first)
+            {
+                result ^= static_cast<std::uint8_t>(*first);
+                result *= UINT64_C(0x100000001b3);
+            }
+            return result;
+        }
+
+        template <class Container, class Key, class = void>
+        struct HasTransparentFind: std::false_type {};
+
+        template <class Container, class Key>
+        struct HasTransparentFind<Container, Key, std::void_t<decltype(std::declval<const Container&>().find(std::declval<const Key&>()))>>: std::true_type {};
+
+        // looks up a key, converting it to the container's key type when the
+        // container does not support heterogeneous lookup (e.g. std::unordered_map)
+        template <class Container>
+        [[nodiscard]] auto mapFind(Container& container, const std::string_view key)
+        {
+            if constexpr (HasTransparentFind<Container, std::string_view>::value)
+                return container.find(key);
+            else
+                return container.find(typename Container::key_type{key});
+        }
+
+        // parses an arithmetic value out of its textual representation
+        template <class T>
+        [[nodiscard]] T convertValue(const std::string_view value)
+        {
+            if constexpr (std::is_same_v<T, bool>)
+            {
+                if (value == "true" || value == "1") return true;
+                if (value == "false" || value == "0") return false;
+                throw ParseError{"Invalid value"};
+            }
+#if !defined(__cpp_lib_to_chars)
+            else if constexpr (std::is_floating_point_v<T>)
+            {
+                // older standard libraries (libstdc++ before GCC 11) only
+                // ship the integral std::from_chars, fall back to strtod and
+                // reject what from_chars would not accept
+                if (value.empty() || isWhiteSpace(value.front()) || value.front() == '+')
+                    throw ParseError{"Invalid value"};
+
+                const std::string text{value};
+                char* parseEnd = nullptr;
+                const auto result = std::strtod(text.c_str(), &parseEnd);
+
+                if (parseEnd != text.c_str() + text.size())
+                    throw ParseError{"Invalid value"};
+
+                return static_cast<T>(result);
+            }
+#endif
+            else
+            {
+                T result{};
+                const auto [pointer, error] = std::from_chars(value.data(), value.data() + value.size(), result);
+
+                if (error != std::errc{} || pointer != value.data() + value.size())
+                    throw ParseError{"Invalid value"};
+
+                return result;
+            }
+        }
+
+        // builds a key for insertion, passing the container's allocator along
+        // when the key type is allocator-aware
+        template <class Container>
+        [[nodiscard]] auto makeKey(const Container& container, const std::string_view key)
+        {
+            if constexpr (std::uses_allocator_v<typename Container::key_type, typename Container::allocator_type>)
+                return typename Container::key_type{key, container.get_allocator()};
+            else
+                return typename Container::key_type{key};
+        }
     }
 
-    class Section final
+    // a monotonic buffer that hands out memory in bump-pointer fashion,
+    // everything allocated from it is reclaimed by a single reset() call
+    class Arena final
+    {
+    public:
+        explicit Arena(const std::size_t initialBlockSize = 4096):
+            nextBlockSize{initialBlockSize}
+        {
+        }
+
+        Arena(const Arena&) = delete;
+        Arena& operator=(const Arena&) = delete;
+
+        [[nodiscard]] void* allocate(const std::size_t size, const std::size_t alignment)
+        {
+            for (auto block = currentBlock; block < blocks.size(); ++block)
+            {
+                auto& [data, capacity, used] = blocks[block];
+                const auto aligned = (used + alignment - 1) / alignment * alignment;
+
+                if (aligned + size <= capacity)
+                {
+                    used = aligned + size;
+                    currentBlock = block;
+                    return data.get() + aligned;
+                }
+            }
+
+            const auto blockSize = std::max(nextBlockSize, size + alignment);
+            blocks.push_back(Block{std::make_unique<char[]>(blockSize), blockSize, size});
+            nextBlockSize = blockSize * 2;
+            currentBlock = blocks.size() - 1;
+            return blocks.back().data.get();
+        }
+
+        // makes all memory available again without returning it to the system
+        void reset() noexcept
+        {
+            for (auto& block : blocks)
+                block.used = 0;
+            currentBlock = 0;
+        }
+
+        [[nodiscard]] std::size_t getCapacity() const noexcept
+        {
+            std::size_t result = 0;
+            for (const auto& block : blocks)
+                result += block.capacity;
+            return result;
+        }
+
+    private:
+        struct Block final
+        {
+            std::unique_ptr<char[]> data;
+            std::size_t capacity;
+            std::size_t used;
+        };
+
+        std::vector<Block> blocks;
+        std::size_t currentBlock = 0;
+        std::size_t nextBlockSize;
+    };
+
+    template <class T>
+    class ArenaAllocator
+    {
+    public:
+        using value_type = T;
+
+        explicit ArenaAllocator(Arena& initArena) noexcept:
+            arena{&initArena}
+        {
+        }
+
+        template <class U>
+        ArenaAllocator(const ArenaAllocator<U>& other) noexcept:
+            arena{other.arena}
+        {
+        }
+
+        [[nodiscard]] T* allocate(const std::size_t n)
+        {
+            return static_cast<T*>(arena->allocate(n * sizeof(T), alignof(T)));
+        }
+
+        void deallocate(T*, std::size_t) noexcept
+        {
+            // memory is reclaimed by Arena::reset
+        }
+
+        [[nodiscard]] bool operator==(const ArenaAllocator& other) const noexcept
+        {
+            return arena == other.arena;
+        }
+
+        [[nodiscard]] bool operator!=(const ArenaAllocator& other) const noexcept
+        {
+            return arena != other.arena;
+        }
+
+    private:
+        template <class U> friend class ArenaAllocator;
+
+        Arena* arena;
+    };
+
+    template <class Container>
+    class BasicSection final
     {
     public:
-        Section() = default;
+        using String = typename Container::mapped_type;
+        using allocator_type = typename Container::allocator_type;
+
+        BasicSection() = default;
 
-        explicit Section(const std::string& initName):
+        explicit BasicSection(const String& initName):
             name{initName}
         {
         }
 
+        explicit BasicSection(const allocator_type& allocator):
+            name{allocator},
+            values{allocator}
+        {
+        }
+
         [[nodiscard]] auto begin() noexcept
         {
             return values.begin();
@@ -97,49 +489,153 @@ namespace ini
             return values.end();
         }
 
-        [[nodiscard]] const std::string& getName() const noexcept { return name; }
-        void setName(const std::string_view newName) { name = newName; }
+        [[nodiscard]] const String& getName() const noexcept { return name; }
+        void setName(const std::string_view newName)
+        {
+            name = newName;
+            version = nextVersion();
+        }
+
+        // increments on every mutation, so caches can tell an unchanged
+        // section apart from a rewritten one without comparing contents
+        [[nodiscard]] std::uint64_t getVersion() const noexcept { return version; }
 
-        [[nodiscard]] const Values& getValues() const noexcept { return values; }
+        [[nodiscard]] const Container& getValues() const noexcept { return values; }
 
         [[nodiscard]] bool hasValue(const std::string_view key) const
         {
-            return values.find(key) != values.end();
+            return mapFind(values, key) != values.end();
         }
 
-        [[nodiscard]] std::string& operator[](const std::string_view key)
+        [[nodiscard]] String& operator[](const std::string_view key)
         {
-            if (const auto iterator = values.find(key); iterator != values.end())
+            invalidate(key);
+            version = nextVersion();
+
+            if (const auto iterator = mapFind(values, key); iterator != values.end())
                 return iterator->second;
             else
             {
-                const auto& [newIterator, success] = values.try_emplace(std::string{key});
+                const auto& [newIterator, success] = values.try_emplace(makeKey(values, key));
                 (void)success;
                 return newIterator->second;
             }
         }
 
         [[nodiscard]]
-        const std::string& operator[](const std::string_view key) const
+        const String& operator[](const std::string_view key) const
         {
-            if (const auto iterator = values.find(key); iterator != values.end())
+            if (const auto iterator = mapFind(values, key); iterator != values.end())
                 return iterator->second;
             else
                 throw RangeError{"Value does not exist"};
         }
 
         [[nodiscard]]
-        const std::string& getValue(const std::string_view key, const std::string& defaultValue = {}) const
+        const String& getValue(const std::string_view key, const String& defaultValue = {}) const
         {
-            if (const auto iterator = values.find(key); iterator != values.end())
+            if (const auto iterator = mapFind(values, key); iterator != values.end())
                 return iterator->second;
 
             return defaultValue;
         }
 
+        // converts the value with std::from_chars and memoizes the result, so
+        // repeated numeric reads of the same key skip the text conversion; the
+        // cache is dropped whenever the section is written to
+        template <class T>
+        [[nodiscard]] T getValue(const std::string_view key) const
+        {
+            static_assert(std::is_arithmetic_v<T>, "getValue<T> supports arithmetic types only");
+
+            using Stored = std::conditional_t<std::is_same_v<T, bool>, bool,
+                           std::conditional_t<std::is_floating_point_v<T>, double,
+                           std::conditional_t<std::is_signed_v<T>, std::int64_t, std::uint64_t>>>;
+
+            if (const auto cached = conversions.find(key); cached != conversions.end())
+                if (const auto stored = std::get_if<Stored>(&cached->second))
+                    return static_cast<T>(*stored);
+
+            const auto iterator = mapFind(values, key);
+            if (iterator == values.end())
+                throw RangeError{"Value does not exist"};
+
+            const auto converted = convertValue<Stored>(std::string_view{iterator->second});
+            conversions.insert_or_assign(std::string{key}, converted);
+            return static_cast<T>(converted);
+        }
+
+        // answers a batch of lookups in a single sweep over the container
+        // instead of one tree descent per key; keys should be sorted for the
+        // ordered containers to get the merge-join pass, unsorted keys fall
+        // back to a fresh descent. Missing keys yield empty views. Returns
+        // the number of keys found.
+        std::size_t getValues(const std::string_view* const keys, const std::size_t keyCount,
+                              std::string_view* const results) const
+        {
+            std::size_t found = 0;
+
+            if constexpr (HasTransparentFind<Container, std::string_view>::value)
+            {
+                auto iterator = values.begin();
+                std::string_view previousKey;
+
+                for (std::size_t key = 0; key < keyCount; ++key)
+                {
+                    if (key != 0 && keys[key] < previousKey)
+                        iterator = values.begin(); // the keys are not sorted, start over
+
+                    previousKey = keys[key];
+
+                    while (iterator != values.end() && std::string_view{iterator->first} < keys[key])
+                        ++iterator;
+
+                    if (iterator != values.end() && std::string_view{iterator->first} == keys[key])
+                    {
+                        results[key] = std::string_view{iterator->second};
+                        ++found;
+                    }
+                    else
+                        results[key] = std::string_view{};
+                }
+            }
+            else
+                for (std::size_t key = 0; key < keyCount; ++key)
+                    if (const auto iterator = mapFind(values, keys[key]); iterator != values.end())
+                    {
+                        results[key] = std::string_view{iterator->second};
+                        ++found;
+                    }
+                    else
+                        results[key] = std::string_view{};
+
+            return found;
+        }
+
+        // bulk-inserts a range of key/value pairs; consecutive keys in order
+        // reuse the previous position as the emplacement hint, so a sorted
+        // batch avoids one full tree descent per pair
+        template <class Iterator>
+        void insert(Iterator first, Iterator last)
+        {
+            conversions.clear();
+            version = nextVersion();
+            auto hint = values.end();
+
+            for (; first != last; ++first)
+            {
+                const auto iterator = values.try_emplace(hint, makeKey(values, std::string_view{first->first}));
+                iterator->second = std::string_view{first->second};
+                hint = std::next(iterator);
+            }
+        }
+
         void deleteValue(const std::string_view key)
         {
-            if (const auto iterator = values.find(key); iterator != values.end())
+            invalidate(key);
+            version = nextVersion();
+
+            if (const auto iterator = mapFind(values, key); iterator != values.end())
                 values.erase(iterator);
         }
 
@@ -148,17 +644,45 @@ namespace ini
             return values.size();
         }
 
+        void clear() noexcept
+        {
+            conversions.clear();
+            values.clear();
+            version = nextVersion();
+        }
+
     private:
-        std::string name;
-        Values values;
+        void invalidate(const std::string_view key) const
+        {
+            if (!conversions.empty())
+                if (const auto iterator = conversions.find(key); iterator != conversions.end())
+                    conversions.erase(iterator);
+        }
+
+        String name;
+        Container values;
+        std::uint64_t version = nextVersion();
+        // memoized getValue<T> conversions, not synchronized across threads
+        mutable std::map<std::string, std::variant<std::int64_t, std::uint64_t, double, bool>, std::less<>> conversions;
     };
 
-    class Data final
+    using Section = BasicSection<Values>;
+
+    template <class Container>
+    class BasicData final
     {
     public:
-        using Sections = std::map<std::string, Section, std::less<>>;
+        using Sections = Container;
+
+        using SectionType = typename Container::mapped_type;
+        using allocator_type = typename Container::allocator_type;
 
-        Data() = default;
+        BasicData() = default;
+
+        explicit BasicData(const allocator_type& allocator):
+            sections{allocator}
+        {
+        }
 
         [[nodiscard]] const Sections& getSections() const noexcept { return sections; }
 
@@ -184,32 +708,64 @@ namespace ini
 
         [[nodiscard]] bool hasSection(const std::string_view name) const
         {
-            return sections.find(name) != sections.end();
+            return mapFind(sections, name) != sections.end();
         }
 
-        [[nodiscard]] Section& operator[](const std::string_view name)
+        [[nodiscard]] SectionType& operator[](const std::string_view name)
         {
-            if (const auto sectionIterator = sections.find(name); sectionIterator != sections.end())
+            if (const auto sectionIterator = mapFind(sections, name); sectionIterator != sections.end())
                 return sectionIterator->second;
             else
             {
-                const auto& [newIterator, success] = sections.try_emplace(std::string{name});
+                const auto& [newIterator, success] = sections.try_emplace(makeKey(sections, name));
                 (void)success;
                 return newIterator->second;
             }
         }
 
-        [[nodiscard]] const Section& operator[](const std::string_view name) const
+        [[nodiscard]] const SectionType& operator[](const std::string_view name) const
         {
-            if (const auto sectionIterator = sections.find(name); sectionIterator != sections.end())
+            if (const auto sectionIterator = mapFind(sections, name); sectionIterator != sections.end())
                 return sectionIterator->second;
             else
                 throw RangeError{"Section does not exist"};
         }
 
+        // remembers the last section it handed out, so a run of insertions
+        // into the same section pays for only one lookup
+        class Cursor final
+        {
+        public:
+            explicit Cursor(BasicData& initData) noexcept:
+                data{initData}
+            {
+            }
+
+            [[nodiscard]] SectionType& operator[](const std::string_view name)
+            {
+                if (!section || currentName != name)
+                {
+                    section = &data[name];
+                    currentName = name;
+                }
+
+                return *section;
+            }
+
+        private:
+            BasicData& data;
+            SectionType* section = nullptr;
+            std::string currentName;
+        };
+
+        [[nodiscard]] Cursor makeCursor() noexcept
+        {
+            return Cursor{*this};
+        }
+
         void eraseSection(const std::string_view name)
         {
-            if (const auto sectionIterator = sections.find(name); sectionIterator != sections.end())
+            if (const auto sectionIterator = mapFind(sections, name); sectionIterator != sections.end())
                 sections.erase(sectionIterator);
         }
 
@@ -222,161 +778,352 @@ namespace ini
         Sections sections;
     };
 
-    template <class Iterator>
-    [[nodiscard]] Data parse(Iterator begin, Iterator end)
-    {
-        class Parser final
-        {
-        public:
-            [[nodiscard]]
-            static Data parse(const Iterator begin, const Iterator end)
-            {
-                Data result;
-
-                std::string section;
+    using Data = BasicData<std::map<std::string, Section, std::less<>>>;
 
-                for (auto iterator = hasByteOrderMark(begin, end) ? begin + 3 : begin; iterator != end;)
-                {
-                    if (isWhiteSpace(static_cast<char>(*iterator)) ||
-                        static_cast<char>(*iterator) == '\n' ||
-                        static_cast<char>(*iterator) == '\r') // line starts with a white space
-                        ++iterator; // skip the white space
-                    else if (static_cast<char>(*iterator) == '[') // section
-                    {
-                        ++iterator; // skip the left bracket
+    using UnorderedValues = std::unordered_map<std::string, std::string>;
+    using UnorderedSection = BasicSection<UnorderedValues>;
+    using UnorderedData = BasicData<std::unordered_map<std::string, UnorderedSection>>;
 
-                        bool parsedSection = false;
+    using ArenaString = std::basic_string<char, std::char_traits<char>, ArenaAllocator<char>>;
+    using ArenaValues = std::map<ArenaString, ArenaString, std::less<>,
+                                 std::scoped_allocator_adaptor<ArenaAllocator<std::pair<const ArenaString, ArenaString>>>>;
+    using ArenaSection = BasicSection<ArenaValues>;
+    using ArenaSections = std::map<ArenaString, ArenaSection, std::less<>,
+                                   std::scoped_allocator_adaptor<ArenaAllocator<std::pair<const ArenaString, ArenaSection>>>>;
+    using ArenaData = BasicData<ArenaSections>;
 
-                        for (;;)
-                        {
-                            if (iterator == end ||
-                                static_cast<char>(*iterator) == '\n' ||
-                                static_cast<char>(*iterator) == '\r')
-                            {
-                                if (!parsedSection)
-                                    throw ParseError{"Unexpected end of section"};
+    using ValueViews = std::map<std::string_view, std::string_view, std::less<>>;
 
-                                ++iterator; // skip the newline
-                                break;
-                            }
-                            else if (static_cast<char>(*iterator) == ';')
-                            {
-                                ++iterator; // skip the semicolon
-
-                                if (!parsedSection)
-                                    throw ParseError{"Unexpected comment"};
-
-                                while (iterator != end)
-                                {
-                                    if (static_cast<char>(*iterator) == '\n' ||
-                                        static_cast<char>(*iterator) == '\r')
-                                    {
-                                        ++iterator; // skip the newline
-                                        break;
-                                    }
-
-                                    ++iterator;
-                                }
-                                break;
-                            }
-                            else if (static_cast<char>(*iterator) == ']')
-                                parsedSection = true;
-                            else if (static_cast<char>(*iterator) != ' ' &&
-                                     static_cast<char>(*iterator) != '\t')
-                            {
-                                if (parsedSection)
-                                    throw ParseError{"Unexpected character after section"};
-                            }
+    class SectionView final
+    {
+    public:
+        SectionView() = default;
 
-                            if (!parsedSection)
-                                section.push_back(static_cast<char>(*iterator));
+        explicit SectionView(const std::string_view initName) noexcept:
+            name{initName}
+        {
+        }
 
-                            ++iterator;
-                        }
+        [[nodiscard]] auto begin() noexcept
+        {
+            return values.begin();
+        }
 
-                        trim(section);
+        [[nodiscard]] auto end() noexcept
+        {
+            return values.end();
+        }
 
-                        if (section.empty())
-                            throw ParseError{"Invalid section name"};
+        [[nodiscard]] auto begin() const noexcept
+        {
+            return values.begin();
+        }
 
-                        result[section] = Section{};
-                    }
-                    else if (static_cast<char>(*iterator) == ';') // comment
+        [[nodiscard]] auto end() const noexcept
+        {
+            return values.end();
+        }
+
+        [[nodiscard]] std::string_view getName() const noexcept { return name; }
+
+        [[nodiscard]] const ValueViews& getValues() const noexcept { return values; }
+
+        [[nodiscard]] bool hasValue(const std::string_view key) const
+        {
+            return values.find(key) != values.end();
+        }
+
+        [[nodiscard]] std::string_view& operator[](const std::string_view key)
+        {
+            if (const auto iterator = values.find(key); iterator != values.end())
+                return iterator->second;
+            else
+            {
+                const auto& [newIterator, success] = values.try_emplace(key);
+                (void)success;
+                return newIterator->second;
+            }
+        }
+
+        [[nodiscard]]
+        std::string_view operator[](const std::string_view key) const
+        {
+            if (const auto iterator = values.find(key); iterator != values.end())
+                return iterator->second;
+            else
+                throw RangeError{"Value does not exist"};
+        }
+
+        [[nodiscard]]
+        std::string_view getValue(const std::string_view key, const std::string_view defaultValue = {}) const
+        {
+            if (const auto iterator = values.find(key); iterator != values.end())
+                return iterator->second;
+
+            return defaultValue;
+        }
+
+        [[nodiscard]] std::size_t getSize() const noexcept
+        {
+            return values.size();
+        }
+
+    private:
+        std::string_view name;
+        ValueViews values;
+    };
+
+    class DataView final
+    {
+    public:
+        using Sections = std::map<std::string_view, SectionView, std::less<>>;
+
+        DataView() = default;
+
+        [[nodiscard]] const Sections& getSections() const noexcept { return sections; }
+
+        [[nodiscard]] auto begin() noexcept
+        {
+            return sections.begin();
+        }
+
+        [[nodiscard]] auto end() noexcept
+        {
+            return sections.end();
+        }
+
+        [[nodiscard]] auto begin() const noexcept
+        {
+            return sections.begin();
+        }
+
+        [[nodiscard]] auto end() const noexcept
+        {
+            return sections.end();
+        }
+
+        [[nodiscard]] bool hasSection(const std::string_view name) const
+        {
+            return sections.find(name) != sections.end();
+        }
+
+        [[nodiscard]] SectionView& operator[](const std::string_view name)
+        {
+            if (const auto sectionIterator = sections.find(name); sectionIterator != sections.end())
+                return sectionIterator->second;
+            else
+            {
+                const auto& [newIterator, success] = sections.try_emplace(name, SectionView{name});
+                (void)success;
+                return newIterator->second;
+            }
+        }
+
+        [[nodiscard]] const SectionView& operator[](const std::string_view name) const
+        {
+            if (const auto sectionIterator = sections.find(name); sectionIterator != sections.end())
+                return sectionIterator->second;
+            else
+                throw RangeError{"Section does not exist"};
+        }
+
+        [[nodiscard]] std::size_t getSize() const noexcept
+        {
+            return sections.size();
+        }
+
+    private:
+        Sections sections;
+    };
+
+    inline namespace detail
+    {
+        template <class DataType, class Iterator>
+        void parseData(DataType& result, const Iterator dataBegin, const Iterator dataEnd)
+        {
+            class Parser final
+            {
+            public:
+                static void parse(DataType& result, const Iterator begin, const Iterator end)
+                {
+                    // scratch buffers reused across lines so steady-state
+                    // parsing does not allocate per line
+                    std::string section;
+                    std::string key;
+                    std::string value;
+
+                    for (auto iterator = hasByteOrderMark(begin, end) ? begin + 3 : begin; iterator != end;)
                     {
-                        while (++iterator != end)
+                        if (isWhiteSpace(static_cast<char>(*iterator)) ||
+                            static_cast<char>(*iterator) == '\n' ||
+                            static_cast<char>(*iterator) == '\r') // line starts with a white space
+                            do // consume the whole run, blank-heavy files are common
+                                ++iterator;
+                            while (iterator != end &&
+                                   (isWhiteSpace(static_cast<char>(*iterator)) ||
+                                    static_cast<char>(*iterator) == '\n' ||
+                                    static_cast<char>(*iterator) == '\r'));
+                        else if (static_cast<char>(*iterator) == '[') // section
                         {
-                            if (static_cast<char>(*iterator) == '\r' ||
+                            ++iterator; // skip the left bracket
+
+                            const auto nameBegin = iterator;
+                            iterator = findAny(iterator, end, ']', ';', '\r', '\n');
+
+                            if (iterator == end ||
+                                static_cast<char>(*iterator) == '\r' ||
                                 static_cast<char>(*iterator) == '\n')
-                            {
-                                ++iterator; // skip the newline
-                                break;
-                            }
-                        }
-                    }
-                    else // key, value pair
-                    {
-                        std::string key;
-                        std::string value;
-                        bool parsedKey = false;
+                                throw ParseError{"Unexpected end of section"};
+                            else if (static_cast<char>(*iterator) == ';')
+                                throw ParseError{"Unexpected comment"};
 
-                        while (iterator != end)
-                        {
-                            if (static_cast<char>(*iterator) == '\r' ||
+                            section.clear();
+                            append(section, nameBegin, iterator);
+                            ++iterator; // skip the right bracket
+
+                            // only white spaces and comments may follow the section
+                            while (iterator != end &&
+                                   isWhiteSpace(static_cast<char>(*iterator)))
+                                ++iterator;
+
+                            if (iterator == end ||
+                                static_cast<char>(*iterator) == '\r' ||
                                 static_cast<char>(*iterator) == '\n')
                             {
-                                ++iterator; // skip the newline
-                                break;
-                            }
-                            else if (static_cast<char>(*iterator) == '=')
-                            {
-                                if (!parsedKey)
-                                    parsedKey = true;
-                                else
-                                    throw ParseError{"Unexpected character"};
+                                if (iterator != end)
+                                    ++iterator; // skip the newline
                             }
                             else if (static_cast<char>(*iterator) == ';')
-                            {
-                                ++iterator; // skip the semicolon
-
-                                while (iterator != end)
-                                {
-                                    if (static_cast<char>(*iterator) == '\r' ||
-                                        static_cast<char>(*iterator) == '\n')
-                                    {
-                                        ++iterator; // skip the newline
-                                        break;
-                                    }
-
-                                    ++iterator;
-                                }
-                                break;
-                            }
+                                iterator = skipLine(iterator, end);
                             else
+                                throw ParseError{"Unexpected character after section"};
+
+                            trim(section);
+
+                            if (section.empty())
+                                throw ParseError{"Invalid section name"};
+
+                            result[section].clear();
+                        }
+                        else if (static_cast<char>(*iterator) == ';') // comment
+                            iterator = skipLine(iterator, end);
+                        else // key, value pair
+                        {
+                            key.clear();
+                            value.clear();
+
+                            auto keyBegin = iterator;
+                            iterator = findAny(iterator, end, '=', ';', '\r', '\n');
+
+                            if (iterator == keyBegin)
+                                throw ParseError{"Invalid key name"};
+
+                            auto keyEnd = iterator;
+                            trimRange(keyBegin, keyEnd);
+                            append(key, keyBegin, keyEnd);
+
+                            if (iterator != end &&
+                                static_cast<char>(*iterator) == '=')
                             {
-                                if (!parsedKey)
-                                    key.push_back(static_cast<char>(*iterator));
-                                else
-                                    value.push_back(static_cast<char>(*iterator));
+                                auto valueBegin = ++iterator; // skip the equals sign
+                                iterator = findAny(iterator, end, '=', ';', '\r', '\n');
+
+                                if (iterator != end &&
+                                    static_cast<char>(*iterator) == '=')
+                                    throw ParseError{"Unexpected character"};
+
+                                auto valueEnd = iterator;
+                                trimRange(valueBegin, valueEnd);
+                                append(value, valueBegin, valueEnd);
                             }
 
-                            ++iterator;
+                            if (iterator != end)
+                                iterator = skipLine(iterator, end);
+
+                            auto& slot = result[section][key];
+
+                            if constexpr (std::is_same_v<std::decay_t<decltype(slot)>, std::string>)
+                                slot = std::move(value);
+                            else
+                                slot = std::string_view{value};
                         }
+                    }
+                }
 
-                        if (key.empty())
-                            throw ParseError{"Invalid key name"};
+            private:
+                [[nodiscard]]
+                static Iterator findAny(Iterator iterator, const Iterator end,
+                                        const char c0, const char c1,
+                                        const char c2, const char c3) noexcept
+                {
+                    if constexpr (std::is_pointer_v<Iterator> &&
+                                  sizeof(std::remove_pointer_t<Iterator>) == 1)
+                    {
+                        const auto first = reinterpret_cast<const char*>(iterator);
+                        const auto last = reinterpret_cast<const char*>(end);
+                        return iterator + (findDelimiter(first, last, c0, c1, c2, c3) - first);
+                    }
+                    else
+                    {
+                        while (iterator != end)
+                        {
+                            const auto c = static_cast<char>(*iterator);
+                            if (c == c0 || c == c1 || c == c2 || c == c3)
+                                break;
 
-                        trim(key);
-                        trim(value);
+                            ++iterator;
+                        }
 
-                        result[section][key] = value;
+                        return iterator;
                     }
                 }
 
-                return result;
-            }
-        };
+                // shrinks the range so it no longer starts or ends with a white space
+                static void trimRange(Iterator& first, Iterator& last) noexcept
+                {
+                    while (first != last && isWhiteSpace(static_cast<char>(*first)))
+                        ++first;
+                    while (last != first && isWhiteSpace(static_cast<char>(*(last - 1))))
+                        --last;
+                }
+
+                [[nodiscard]]
+                static Iterator skipLine(Iterator iterator, const Iterator end) noexcept
+                {
+                    iterator = findAny(iterator, end, '\r', '\n', '\r', '\n');
+                    if (iterator != end)
+                        ++iterator; // skip the newline
+                    return iterator;
+                }
+
+                static void append(std::string& string, const Iterator first, const Iterator last)
+                {
+                    string.reserve(string.size() + static_cast<std::size_t>(last - first));
+                    for (auto i = first; i != last; ++i)
+                        string.push_back(static_cast<char>(*i));
+                }
+            };
+
+            Parser::parse(result, dataBegin, dataEnd);
+        }
+    }
 
-        return Parser::parse(begin, end);
+    template <class Iterator>
+    [[nodiscard]] Data parse(Iterator begin, Iterator end)
+    {
+        Data result;
+        parseData(result, begin, end);
+        return result;
+    }
+
+    // parses into storage drawn from the caller-supplied arena, so the whole
+    // result is released by a single Arena::reset
+    template <class Iterator>
+    [[nodiscard]] ArenaData parse(Iterator begin, Iterator end, Arena& arena)
+    {
+        ArenaData result{ArenaAllocator<char>{arena}};
+        parseData(result, begin, end);
+        return result;
     }
 
     [[nodiscard]] inline Data parse(const char* data)
@@ -387,39 +1134,2084 @@ namespace ini
     template <class T>
     [[nodiscard]] Data parse(const T& data)
     {
-        using std::begin, std::end; // add std::begin and std::end to lookup
-        return parse(begin(data), end(data));
+        // strings, vectors and other contiguous byte containers go through
+        // the pointer path so the vectorized delimiter scan engages
+        if constexpr (HasContiguousByteData<T>::value)
+        {
+            const auto contiguous = reinterpret_cast<const char*>(std::data(data));
+            return parse(contiguous, contiguous + std::size(data));
+        }
+        else
+        {
+            using std::begin, std::end; // add std::begin and std::end to lookup
+            return parse(begin(data), end(data));
+        }
     }
 
-    [[nodiscard]]
-    inline std::string encode(const Data& data, const bool byteOrderMark = false)
+    // the outcome of tryParse: an error code plus the position of the
+    // offending character, filled instead of throwing
+    struct ParseResult final
     {
-        std::string result;
+        enum class Error
+        {
+            none,
+            unexpectedEndOfSection,
+            unexpectedComment,
+            unexpectedCharacterAfterSection,
+            invalidSectionName,
+            unexpectedCharacter,
+            invalidKeyName
+        };
 
-        if (byteOrderMark) result.assign(utf8ByteOrderMark.begin(),
-                                         utf8ByteOrderMark.end());
+        Error error = Error::none;
+        std::size_t offset = 0; // byte offset of the offending character
+        std::size_t line = 0; // one-based line of the offending character
 
-        for (const auto& [name, section] : data)
+        [[nodiscard]] explicit operator bool() const noexcept { return error == Error::none; }
+
+        [[nodiscard]] const char* getMessage() const noexcept
         {
-            if (!name.empty())
+            switch (error)
             {
-                result.push_back('[');
-                result.insert(result.end(), name.begin(), name.end());
-                result.push_back(']');
-                result.push_back('\n');
+                case Error::none: return "No error";
+                case Error::unexpectedEndOfSection: return "Unexpected end of section";
+                case Error::unexpectedComment: return "Unexpected comment";
+                case Error::unexpectedCharacterAfterSection: return "Unexpected character after section";
+                case Error::invalidSectionName: return "Invalid section name";
+                case Error::unexpectedCharacter: return "Unexpected character";
+                case Error::invalidKeyName: return "Invalid key name";
             }
 
-            for (const auto& [key, value] : section)
+            return "Unknown error";
+        }
+    };
+
+    // parses like parse but reports malformed input through the status
+    // instead of throwing, so rejecting a bad file costs no stack unwinding;
+    // on failure the partially filled result should be discarded
+    [[nodiscard]] inline bool tryParse(const char* begin, const char* end, Data& result, ParseResult& status)
+    {
+        status = ParseResult{};
+        auto cursor = result.makeCursor();
+        std::string_view section;
+
+        const auto fail = [begin, &status](const ParseResult::Error error, const char* const at) noexcept {
+            status.error = error;
+            status.offset = static_cast<std::size_t>(at - begin);
+            status.line = 1 + static_cast<std::size_t>(std::count(begin, at, '\n'));
+            return false;
+        };
+
+        for (auto iterator = hasByteOrderMark(begin, end) ? begin + 3 : begin; iterator != end;)
+        {
+            if (isWhiteSpace(*iterator) ||
+                *iterator == '\n' ||
+                *iterator == '\r') // line starts with a white space
+                do // consume the whole run, blank-heavy files are common
+                    ++iterator;
+                while (iterator != end &&
+                       (isWhiteSpace(*iterator) || *iterator == '\n' || *iterator == '\r'));
+            else if (*iterator == '[') // section
+            {
+                ++iterator; // skip the left bracket
+
+                const auto nameBegin = iterator;
+                iterator = findDelimiter(iterator, end, ']', ';', '\r', '\n');
+
+                if (iterator == end ||
+                    *iterator == '\r' ||
+                    *iterator == '\n')
+                    return fail(ParseResult::Error::unexpectedEndOfSection, iterator);
+                else if (*iterator == ';')
+                    return fail(ParseResult::Error::unexpectedComment, iterator);
+
+                const auto name = trim(std::string_view{nameBegin, static_cast<std::size_t>(iterator - nameBegin)});
+                ++iterator; // skip the right bracket
+
+                // only white spaces and comments may follow the section
+                while (iterator != end && isWhiteSpace(*iterator))
+                    ++iterator;
+
+                if (iterator == end ||
+                    *iterator == '\r' ||
+                    *iterator == '\n')
+                {
+                    if (iterator != end)
+                        ++iterator; // skip the newline
+                }
+                else if (*iterator == ';')
+                    skipComment(iterator, end);
+                else
+                    return fail(ParseResult::Error::unexpectedCharacterAfterSection, iterator);
+
+                if (name.empty())
+                    return fail(ParseResult::Error::invalidSectionName, nameBegin);
+
+                section = name;
+                cursor[section].clear();
+            }
+            else if (*iterator == ';') // comment
+                skipComment(iterator, end);
+            else // key, value pair
             {
-                result.insert(result.end(), key.begin(), key.end());
-                result.push_back('=');
-                result.insert(result.end(), value.begin(), value.end());
-                result.push_back('\n');
+                const auto keyBegin = iterator;
+                iterator = findDelimiter(iterator, end, '=', ';', '\r', '\n');
+
+                if (iterator == keyBegin)
+                    return fail(ParseResult::Error::invalidKeyName, keyBegin);
+
+                const auto keyEnd = iterator;
+                auto valueBegin = iterator;
+                auto valueEnd = iterator;
+
+                if (iterator != end && *iterator == '=')
+                {
+                    valueBegin = ++iterator; // skip the equals sign
+                    iterator = findDelimiter(iterator, end, '=', ';', '\r', '\n');
+
+                    if (iterator != end && *iterator == '=')
+                        return fail(ParseResult::Error::unexpectedCharacter, iterator);
+
+                    valueEnd = iterator;
+                }
+
+                if (iterator != end && *iterator == ';')
+                    skipComment(iterator, end);
+                else if (iterator != end)
+                    ++iterator; // skip the newline
+
+                const auto key = trim(std::string_view{keyBegin, static_cast<std::size_t>(keyEnd - keyBegin)});
+                const auto value = trim(std::string_view{valueBegin, static_cast<std::size_t>(valueEnd - valueBegin)});
+
+                cursor[section][key] = value;
             }
         }
 
-        return result;
+        return true;
+    }
+
+    [[nodiscard]] inline bool tryParse(const std::string_view data, Data& result, ParseResult& status)
+    {
+        return tryParse(data.data(), data.data() + data.size(), result, status);
     }
+
+    // streams parse events to the handler without building any data structure;
+    // the string_view arguments point into the caller-owned buffer
+    template <class Handler>
+    void parseEvents(const char* begin, const char* end, Handler& handler)
+    {
+        class Parser final
+        {
+        public:
+            static void parse(const char* begin, const char* end, Handler& handler)
+            {
+                for (auto iterator = hasByteOrderMark(begin, end) ? begin + 3 : begin; iterator != end;)
+                {
+                    if (isWhiteSpace(*iterator) ||
+                        *iterator == '\n' ||
+                        *iterator == '\r') // line starts with a white space
+                        do // consume the whole run, blank-heavy files are common
+                            ++iterator;
+                        while (iterator != end &&
+                               (isWhiteSpace(*iterator) || *iterator == '\n' || *iterator == '\r'));
+                    else if (*iterator == '[') // section
+                    {
+                        ++iterator; // skip the left bracket
+
+                        const auto nameBegin = iterator;
+                        iterator = findDelimiter(iterator, end, ']', ';', '\r', '\n');
+
+                        if (iterator == end ||
+                            *iterator == '\r' ||
+                            *iterator == '\n')
+                            throw ParseError{"Unexpected end of section"};
+                        else if (*iterator == ';')
+                            throw ParseError{"Unexpected comment"};
+
+                        const auto section = trim(std::string_view{nameBegin, static_cast<std::size_t>(iterator - nameBegin)});
+                        ++iterator; // skip the right bracket
+
+                        // only white spaces and comments may follow the section
+                        while (iterator != end && isWhiteSpace(*iterator))
+                            ++iterator;
+
+                        std::string_view comment;
+                        bool hasComment = false;
+
+                        if (iterator == end ||
+                            *iterator == '\r' ||
+                            *iterator == '\n')
+                        {
+                            if (iterator != end)
+                                ++iterator; // skip the newline
+                        }
+                        else if (*iterator == ';')
+                        {
+                            comment = commentText(iterator, end);
+                            hasComment = true;
+                        }
+                        else
+                            throw ParseError{"Unexpected character after section"};
+
+                        if (section.empty())
+                            throw ParseError{"Invalid section name"};
+
+                        handler.onSection(section);
+                        if (hasComment) handler.onComment(comment);
+                    }
+                    else if (*iterator == ';') // comment
+                        handler.onComment(commentText(iterator, end));
+                    else // key, value pair
+                    {
+                        const auto keyBegin = iterator;
+                        iterator = findDelimiter(iterator, end, '=', ';', '\r', '\n');
+
+                        if (iterator == keyBegin)
+                            throw ParseError{"Invalid key name"};
+
+                        const auto keyEnd = iterator;
+                        auto valueBegin = iterator;
+                        auto valueEnd = iterator;
+
+                        if (iterator != end && *iterator == '=')
+                        {
+                            valueBegin = ++iterator; // skip the equals sign
+                            iterator = findDelimiter(iterator, end, '=', ';', '\r', '\n');
+
+                            if (iterator != end && *iterator == '=')
+                                throw ParseError{"Unexpected character"};
+
+                            valueEnd = iterator;
+                        }
+
+                        std::string_view comment;
+                        bool hasComment = false;
+
+                        if (iterator != end && *iterator == ';')
+                        {
+                            comment = commentText(iterator, end);
+                            hasComment = true;
+                        }
+                        else if (iterator != end)
+                            ++iterator; // skip the newline
+
+                        const auto key = trim(std::string_view{keyBegin, static_cast<std::size_t>(keyEnd - keyBegin)});
+                        const auto value = trim(std::string_view{valueBegin, static_cast<std::size_t>(valueEnd - valueBegin)});
+
+                        handler.onKeyValue(key, value);
+                        if (hasComment) handler.onComment(comment);
+                    }
+                }
+            }
+
+        private:
+            // consumes a comment starting at the semicolon and returns its text,
+            // the passed iterator is advanced past the terminating newline
+            [[nodiscard]]
+            static std::string_view commentText(const char*& iterator, const char* const end) noexcept
+            {
+                const auto commentBegin = ++iterator; // skip the semicolon
+                iterator = findDelimiter(iterator, end, '\r', '\n', '\r', '\n');
+                const std::string_view comment{commentBegin, static_cast<std::size_t>(iterator - commentBegin)};
+                if (iterator != end)
+                    ++iterator; // skip the newline
+                return comment;
+            }
+        };
+
+        Parser::parse(begin, end, handler);
+    }
+
+    template <class Handler>
+    void parseEvents(const char* data, Handler& handler)
+    {
+        parseEvents(data, data + std::strlen(data), handler);
+    }
+
+    template <class Handler>
+    void parseEvents(const std::string_view data, Handler& handler)
+    {
+        parseEvents(data.data(), data.data() + data.size(), handler);
+    }
+
+    // how a parse treats re-declared keys; with any policy a re-opened
+    // section merges into the already parsed one in place instead of being
+    // destroyed and rebuilt, which is what concatenated bundles need
+    enum class DuplicatePolicy
+    {
+        overwrite, // the last value wins
+        keepFirst, // the first value wins
+        append // the values accumulate, separated by commas
+    };
+
+    // parses like parse but applies the policy to duplicate keys and merges
+    // re-declared sections instead of resetting them
+    [[nodiscard]] inline Data parse(const char* begin, const char* end, const DuplicatePolicy policy)
+    {
+        class Builder final
+        {
+        public:
+            Builder(Data& initResult, const DuplicatePolicy initPolicy) noexcept:
+                cursor{initResult.makeCursor()}, policy{initPolicy}
+            {
+            }
+
+            void onSection(const std::string_view name)
+            {
+                section = name;
+                (void)cursor[section]; // materialize, a re-opened section merges in place
+            }
+
+            void onKeyValue(const std::string_view key, const std::string_view value)
+            {
+                auto& target = cursor[section];
+
+                switch (policy)
+                {
+                    case DuplicatePolicy::overwrite:
+                        target[key] = value;
+                        break;
+                    case DuplicatePolicy::keepFirst:
+                        if (!target.hasValue(key))
+                            target[key] = value;
+                        break;
+                    case DuplicatePolicy::append:
+                        if (auto& slot = target[key]; slot.empty())
+                            slot = value;
+                        else
+                        {
+                            slot += ',';
+                            slot += value;
+                        }
+                        break;
+                }
+            }
+
+            void onComment(std::string_view) noexcept
+            {
+            }
+
+        private:
+            Data::Cursor cursor;
+            DuplicatePolicy policy;
+            std::string_view section;
+        };
+
+        Data result;
+        Builder builder{result, policy};
+        parseEvents(begin, end, builder);
+        return result;
+    }
+
+    [[nodiscard]] inline Data parse(const std::string_view data, const DuplicatePolicy policy)
+    {
+        return parse(data.data(), data.data() + data.size(), policy);
+    }
+
+    // cheap counters describing what a parse consumed, for spotting
+    // degenerate inputs (one enormous value, thousands of empty sections)
+    // without attaching a profiler; per-event callbacks are available through
+    // parseEvents
+    struct ParseStats final
+    {
+        std::size_t bytes = 0;
+        std::size_t lines = 0;
+        std::size_t sections = 0;
+        std::size_t keys = 0;
+        std::size_t comments = 0;
+        std::size_t emptySections = 0;
+        std::size_t maxValueLength = 0;
+    };
+
+    // parses like parse and fills the counters on the way
+    [[nodiscard]] inline Data parse(const char* begin, const char* end, ParseStats& stats)
+    {
+        class Builder final
+        {
+        public:
+            Builder(Data& initResult, ParseStats& initStats) noexcept:
+                cursor{initResult.makeCursor()}, stats{initStats}
+            {
+            }
+
+            void onSection(const std::string_view name)
+            {
+                finishSection();
+                inSection = true;
+                sectionKeys = 0;
+                ++stats.sections;
+
+                section = name;
+                cursor[section].clear();
+            }
+
+            void onKeyValue(const std::string_view key, const std::string_view value)
+            {
+                ++stats.keys;
+                ++sectionKeys;
+                stats.maxValueLength = std::max(stats.maxValueLength, value.size());
+
+                cursor[section][key] = value;
+            }
+
+            void onComment(std::string_view) noexcept
+            {
+                ++stats.comments;
+            }
+
+            // counts the last section if it stayed empty
+            void finishSection() noexcept
+            {
+                if (inSection && sectionKeys == 0)
+                    ++stats.emptySections;
+            }
+
+        private:
+            Data::Cursor cursor;
+            ParseStats& stats;
+            std::string_view section;
+            std::size_t sectionKeys = 0;
+            bool inSection = false;
+        };
+
+        stats = ParseStats{};
+        stats.bytes = static_cast<std::size_t>(end - begin);
+        stats.lines = static_cast<std::size_t>(std::count(begin, end, '\n')) +
+            (begin != end && *(end - 1) != '\n' ? 1 : 0);
+
+        Data result;
+        Builder builder{result, stats};
+        parseEvents(begin, end, builder);
+        builder.finishSection();
+        return result;
+    }
+
+    [[nodiscard]] inline Data parse(const std::string_view data, ParseStats& stats)
+    {
+        return parse(data.data(), data.data() + data.size(), stats);
+    }
+
+    // parses without copying, the returned views point into the caller-owned buffer
+    [[nodiscard]] inline DataView parseView(const char* begin, const char* end)
+    {
+        class Builder final
+        {
+        public:
+            explicit Builder(DataView& initResult) noexcept:
+                result{initResult}
+            {
+            }
+
+            void onSection(const std::string_view name)
+            {
+                section = name;
+                result[name] = SectionView{name};
+            }
+
+            void onKeyValue(const std::string_view key, const std::string_view value)
+            {
+                result[section][key] = value;
+            }
+
+            void onComment(std::string_view) noexcept
+            {
+            }
+
+        private:
+            DataView& result;
+            std::string_view section;
+        };
+
+        DataView result;
+        Builder builder{result};
+        parseEvents(begin, end, builder);
+        return result;
+    }
+
+    [[nodiscard]] inline DataView parseView(const char* data)
+    {
+        return parseView(data, data + std::strlen(data));
+    }
+
+    [[nodiscard]] inline DataView parseView(const std::string_view data)
+    {
+        return parseView(data.data(), data.data() + data.size());
+    }
+
+    // deduplicates the strings of many parsed files: across thousands of
+    // similar configurations the same key and section names repeat endlessly,
+    // and interning lets every occurrence share one stable allocation, so
+    // identical views can even be compared by pointer
+    class StringPool final
+    {
+    public:
+        [[nodiscard]] std::string_view intern(const std::string_view string)
+        {
+            auto iterator = strings.find(string);
+            if (iterator == strings.end())
+                iterator = strings.emplace(string).first;
+
+            return std::string_view{*iterator};
+        }
+
+        [[nodiscard]] std::size_t getSize() const noexcept { return strings.size(); }
+
+    private:
+        // node-based storage keeps the handed-out views stable
+        std::set<std::string, std::less<>> strings;
+    };
+
+    // parses into views backed by the pool instead of the input buffer, so the
+    // result outlives the buffer and repeated strings are stored only once
+    [[nodiscard]] inline DataView parse(const char* begin, const char* end, StringPool& pool)
+    {
+        class Builder final
+        {
+        public:
+            Builder(DataView& initResult, StringPool& initPool) noexcept:
+                result{initResult}, pool{initPool}
+            {
+            }
+
+            void onSection(const std::string_view name)
+            {
+                section = pool.intern(name);
+                result[section] = SectionView{section};
+            }
+
+            void onKeyValue(const std::string_view key, const std::string_view value)
+            {
+                result[section][pool.intern(key)] = pool.intern(value);
+            }
+
+            void onComment(std::string_view) noexcept
+            {
+            }
+
+        private:
+            DataView& result;
+            StringPool& pool;
+            std::string_view section;
+        };
+
+        DataView result;
+        Builder builder{result, pool};
+        parseEvents(begin, end, builder);
+        return result;
+    }
+
+    [[nodiscard]] inline DataView parse(const char* data, StringPool& pool)
+    {
+        return parse(data, data + std::strlen(data), pool);
+    }
+
+    [[nodiscard]] inline DataView parse(const std::string_view data, StringPool& pool)
+    {
+        return parse(data.data(), data.data() + data.size(), pool);
+    }
+
+    struct StaticEntry final
+    {
+        std::string_view section;
+        std::string_view key;
+        std::string_view value;
+    };
+
+    // a fixed-capacity, constexpr-friendly parse result; the views point into
+    // the parsed buffer, which for compile-time use is a string literal
+    template <std::size_t Capacity>
+    class StaticData final
+    {
+    public:
+        [[nodiscard]] constexpr auto begin() const noexcept
+        {
+            return entries.data();
+        }
+
+        [[nodiscard]] constexpr auto end() const noexcept
+        {
+            return entries.data() + entryCount;
+        }
+
+        [[nodiscard]] constexpr std::size_t getSize() const noexcept
+        {
+            return entryCount;
+        }
+
+        [[nodiscard]] constexpr bool hasValue(const std::string_view section, const std::string_view key) const noexcept
+        {
+            for (const auto& entry : *this)
+                if (entry.section == section && entry.key == key)
+                    return true;
+            return false;
+        }
+
+        [[nodiscard]] constexpr std::string_view getValue(const std::string_view section, const std::string_view key,
+                                                          const std::string_view defaultValue = {}) const noexcept
+        {
+            for (const auto& entry : *this)
+                if (entry.section == section && entry.key == key)
+                    return entry.value;
+            return defaultValue;
+        }
+
+        constexpr void insert(const std::string_view section, const std::string_view key, const std::string_view value)
+        {
+            for (auto entry = entries.data(); entry != entries.data() + entryCount; ++entry)
+                if (entry->section == section && entry->key == key)
+                {
+                    entry->value = value; // the last occurrence wins, as in parse
+                    return;
+                }
+
+            if (entryCount == Capacity)
+                throw RangeError{"Capacity exceeded"};
+
+            entries[entryCount++] = StaticEntry{section, key, value};
+        }
+
+        // drops every entry of the section, as a re-declared header does in
+        // the runtime parser
+        constexpr void eraseSection(const std::string_view section) noexcept
+        {
+            std::size_t kept = 0;
+            for (std::size_t entry = 0; entry < entryCount; ++entry)
+                if (entries[entry].section != section)
+                    entries[kept++] = entries[entry];
+
+            entryCount = kept;
+        }
+
+    private:
+        std::array<StaticEntry, Capacity> entries{};
+        std::size_t entryCount = 0;
+    };
+
+    // a constexpr parse variant for baking default configurations into the
+    // binary; malformed input or overflowing the capacity fails the build
+    // when evaluated at compile time
+    template <std::size_t Capacity>
+    [[nodiscard]] constexpr StaticData<Capacity> parseStatic(const std::string_view input)
+    {
+        constexpr auto findAny = [](const std::string_view text, std::size_t position,
+                                    const char c0, const char c1, const char c2, const char c3) constexpr noexcept {
+            while (position < text.size())
+            {
+                const auto c = text[position];
+                if (c == c0 || c == c1 || c == c2 || c == c3)
+                    break;
+                ++position;
+            }
+            return position;
+        };
+
+        constexpr auto skipLine = [](const std::string_view text, std::size_t position) constexpr noexcept {
+            while (position < text.size() && text[position] != '\r' && text[position] != '\n')
+                ++position;
+            return position < text.size() ? position + 1 : position; // skip the newline
+        };
+
+        StaticData<Capacity> result;
+        std::string_view section;
+
+        std::size_t i = input.size() >= 3 &&
+            static_cast<std::uint8_t>(input[0]) == utf8ByteOrderMark[0] &&
+            static_cast<std::uint8_t>(input[1]) == utf8ByteOrderMark[1] &&
+            static_cast<std::uint8_t>(input[2]) == utf8ByteOrderMark[2] ? 3 : 0;
+
+        while (i < input.size())
+        {
+            if (isWhiteSpace(input[i]) ||
+                input[i] == '\n' ||
+                input[i] == '\r') // line starts with a white space
+                ++i; // skip the white space
+            else if (input[i] == '[') // section
+            {
+                ++i; // skip the left bracket
+
+                const auto nameBegin = i;
+                i = findAny(input, i, ']', ';', '\r', '\n');
+
+                if (i == input.size() || input[i] == '\r' || input[i] == '\n')
+                    throw ParseError{"Unexpected end of section"};
+                else if (input[i] == ';')
+                    throw ParseError{"Unexpected comment"};
+
+                section = trim(input.substr(nameBegin, i - nameBegin));
+                ++i; // skip the right bracket
+
+                // only white spaces and comments may follow the section
+                while (i < input.size() && isWhiteSpace(input[i]))
+                    ++i;
+
+                if (i == input.size() || input[i] == '\r' || input[i] == '\n')
+                    ++i; // skip the newline
+                else if (input[i] == ';')
+                    i = skipLine(input, i);
+                else
+                    throw ParseError{"Unexpected character after section"};
+
+                if (section.empty())
+                    throw ParseError{"Invalid section name"};
+
+                result.eraseSection(section); // a re-declared section resets
+            }
+            else if (input[i] == ';') // comment
+                i = skipLine(input, i);
+            else // key, value pair
+            {
+                const auto keyBegin = i;
+                i = findAny(input, i, '=', ';', '\r', '\n');
+
+                if (i == keyBegin)
+                    throw ParseError{"Invalid key name"};
+
+                const auto key = trim(input.substr(keyBegin, i - keyBegin));
+                std::string_view value;
+
+                if (i < input.size() && input[i] == '=')
+                {
+                    const auto valueBegin = ++i; // skip the equals sign
+                    i = findAny(input, i, '=', ';', '\r', '\n');
+
+                    if (i < input.size() && input[i] == '=')
+                        throw ParseError{"Unexpected character"};
+
+                    value = trim(input.substr(valueBegin, i - valueBegin));
+                }
+
+                i = skipLine(input, i);
+
+                result.insert(section, key, value);
+            }
+        }
+
+        return result;
+    }
+
+    // a read-only mapping of a file, obtained with mmap/MapViewOfFile where
+    // available so no copy of the contents is made
+    class FileMapping final
+    {
+    public:
+        explicit FileMapping(const std::filesystem::path& path)
+        {
+#if defined(INI_MMAP_POSIX)
+            const auto descriptor = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+            if (descriptor == -1)
+                throw FileError{"Failed to open " + path.string()};
+
+            struct stat status;
+            if (::fstat(descriptor, &status) == -1)
+            {
+                ::close(descriptor);
+                throw FileError{"Failed to get the size of " + path.string()};
+            }
+
+            size = static_cast<std::size_t>(status.st_size);
+
+            if (size != 0)
+            {
+                mapping = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+
+                if (mapping == MAP_FAILED)
+                {
+                    ::close(descriptor);
+                    throw FileError{"Failed to map " + path.string()};
+                }
+            }
+
+            ::close(descriptor);
+#elif defined(INI_MMAP_WINDOWS)
+            file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                               OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+            if (file == INVALID_HANDLE_VALUE)
+                throw FileError{"Failed to open " + path.string()};
+
+            LARGE_INTEGER fileSize;
+            if (!GetFileSizeEx(file, &fileSize))
+            {
+                CloseHandle(file);
+                throw FileError{"Failed to get the size of " + path.string()};
+            }
+
+            size = static_cast<std::size_t>(fileSize.QuadPart);
+
+            if (size != 0)
+            {
+                fileMapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+                if (!fileMapping)
+                {
+                    CloseHandle(file);
+                    throw FileError{"Failed to map " + path.string()};
+                }
+
+                mapping = MapViewOfFile(fileMapping, FILE_MAP_READ, 0, 0, 0);
+                if (!mapping)
+                {
+                    CloseHandle(fileMapping);
+                    CloseHandle(file);
+                    throw FileError{"Failed to map a view of " + path.string()};
+                }
+            }
+#else
+            std::ifstream file{path, std::ios::binary};
+            if (!file)
+                throw FileError{"Failed to open " + path.string()};
+
+            contents.assign(std::istreambuf_iterator<char>{file},
+                            std::istreambuf_iterator<char>{});
+            size = contents.size();
+#endif
+        }
+
+        ~FileMapping()
+        {
+#if defined(INI_MMAP_POSIX)
+            if (mapping != MAP_FAILED)
+                ::munmap(mapping, size);
+#elif defined(INI_MMAP_WINDOWS)
+            if (mapping) UnmapViewOfFile(mapping);
+            if (fileMapping) CloseHandle(fileMapping);
+            if (file != INVALID_HANDLE_VALUE) CloseHandle(file);
+#endif
+        }
+
+        FileMapping(const FileMapping&) = delete;
+        FileMapping& operator=(const FileMapping&) = delete;
+
+        [[nodiscard]] const char* getData() const noexcept
+        {
+#if defined(INI_MMAP_POSIX)
+            return mapping != MAP_FAILED ? static_cast<const char*>(mapping) : nullptr;
+#elif defined(INI_MMAP_WINDOWS)
+            return static_cast<const char*>(mapping);
+#else
+            return contents.data();
+#endif
+        }
+
+        [[nodiscard]] std::size_t getSize() const noexcept
+        {
+            return size;
+        }
+
+        [[nodiscard]] std::string_view getView() const noexcept
+        {
+            return {getData(), size};
+        }
+
+    private:
+#if defined(INI_MMAP_POSIX)
+        void* mapping = MAP_FAILED;
+#elif defined(INI_MMAP_WINDOWS)
+        HANDLE file = INVALID_HANDLE_VALUE;
+        HANDLE fileMapping = nullptr;
+        void* mapping = nullptr;
+#else
+        std::string contents;
+#endif
+        std::size_t size = 0;
+    };
+
+    // maps the file and feeds the mapping straight into the contiguous parser,
+    // keep a FileMapping alive and use parseView to avoid the owning copy too
+    [[nodiscard]] inline Data parseFile(const std::filesystem::path& path)
+    {
+        const FileMapping mapping{path};
+        return parse(mapping.getData(), mapping.getData() + mapping.getSize());
+    }
+
+    // parses a batch of files across a thread pool; the results are returned
+    // in the order of the paths and the first failure is rethrown after all
+    // workers have finished
+    [[nodiscard]] inline std::vector<Data> parseMany(const std::vector<std::filesystem::path>& paths,
+                                                     const std::size_t threadCount = std::thread::hardware_concurrency())
+    {
+        std::vector<Data> results(paths.size());
+        std::vector<std::exception_ptr> errors(paths.size());
+        std::atomic<std::size_t> nextPath{0};
+
+        const auto worker = [&]() noexcept {
+            for (auto path = nextPath++; path < paths.size(); path = nextPath++)
+                try
+                {
+                    results[path] = parseFile(paths[path]);
+                }
+                catch (...)
+                {
+                    errors[path] = std::current_exception();
+                }
+        };
+
+        if (const auto workerCount = std::min(threadCount, paths.size()); workerCount > 1)
+        {
+            std::vector<std::thread> threads;
+            threads.reserve(workerCount);
+
+            for (std::size_t thread = 0; thread < workerCount; ++thread)
+                threads.emplace_back(worker);
+
+            for (auto& thread : threads)
+                thread.join();
+        }
+        else
+            worker();
+
+        for (const auto& error : errors)
+            if (error)
+                std::rethrow_exception(error);
+
+        return results;
+    }
+
+    inline namespace detail
+    {
+        // finds the next line that starts a section so a chunk boundary never
+        // falls inside one, the only cross-line parser state is the current
+        // section name
+        [[nodiscard]] inline const char* findSectionStart(const char* iterator, const char* end) noexcept
+        {
+            while (iterator != end)
+            {
+                while (iterator != end && *iterator != '\r' && *iterator != '\n')
+                    ++iterator;
+
+                while (iterator != end && (*iterator == '\r' || *iterator == '\n'))
+                    ++iterator;
+
+                auto lineStart = iterator;
+                while (lineStart != end && isWhiteSpace(*lineStart))
+                    ++lineStart;
+
+                if (lineStart != end && *lineStart == '[')
+                    return iterator;
+            }
+
+            return end;
+        }
+    }
+
+    // parses one large buffer on multiple threads by splitting it at section
+    // headers, the per-chunk results merge with the same last-section-wins
+    // semantics as a serial parse
+    [[nodiscard]] inline Data parseParallel(const char* begin, const char* end,
+                                            const std::size_t threadCount = std::thread::hardware_concurrency())
+    {
+        const auto size = static_cast<std::size_t>(end - begin);
+        const auto workerCount = std::min(threadCount, size / 4096);
+
+        if (workerCount <= 1)
+            return parse(begin, end);
+
+        std::vector<const char*> boundaries{begin};
+        for (std::size_t worker = 1; worker < workerCount; ++worker)
+        {
+            const auto boundary = findSectionStart(begin + size * worker / workerCount, end);
+            if (boundary != boundaries.back() && boundary != end)
+                boundaries.push_back(boundary);
+        }
+        boundaries.push_back(end);
+
+        const auto chunkCount = boundaries.size() - 1;
+        std::vector<Data> chunks(chunkCount);
+        std::vector<std::exception_ptr> errors(chunkCount);
+        std::atomic<std::size_t> nextChunk{0};
+
+        const auto worker = [&]() noexcept {
+            for (auto chunk = nextChunk++; chunk < chunkCount; chunk = nextChunk++)
+                try
+                {
+                    chunks[chunk] = parse(boundaries[chunk], boundaries[chunk + 1]);
+                }
+                catch (...)
+                {
+                    errors[chunk] = std::current_exception();
+                }
+        };
+
+        std::vector<std::thread> threads;
+        threads.reserve(chunkCount);
+
+        for (std::size_t thread = 0; thread < chunkCount; ++thread)
+            threads.emplace_back(worker);
+
+        for (auto& thread : threads)
+            thread.join();
+
+        for (const auto& error : errors)
+            if (error)
+                std::rethrow_exception(error);
+
+        Data result = std::move(chunks.front());
+        for (std::size_t chunk = 1; chunk < chunkCount; ++chunk)
+            for (auto& [name, section] : chunks[chunk])
+                result[name] = std::move(section);
+
+        return result;
+    }
+
+    [[nodiscard]] inline Data parseParallel(const std::string_view data,
+                                            const std::size_t threadCount = std::thread::hardware_concurrency())
+    {
+        return parseParallel(data.data(), data.data() + data.size(), threadCount);
+    }
+
+    inline namespace detail
+    {
+        constexpr std::array<char, 4> binaryMagic = {'I', 'N', 'I', '\x01'};
+
+        inline void writeUint32(std::vector<char>& output, const std::uint32_t value)
+        {
+            output.push_back(static_cast<char>(value & 0xFF));
+            output.push_back(static_cast<char>((value >> 8) & 0xFF));
+            output.push_back(static_cast<char>((value >> 16) & 0xFF));
+            output.push_back(static_cast<char>((value >> 24) & 0xFF));
+        }
+
+        [[nodiscard]]
+        inline std::uint32_t readUint32(const char* const data) noexcept
+        {
+            return static_cast<std::uint32_t>(static_cast<std::uint8_t>(data[0])) |
+                   static_cast<std::uint32_t>(static_cast<std::uint8_t>(data[1])) << 8 |
+                   static_cast<std::uint32_t>(static_cast<std::uint8_t>(data[2])) << 16 |
+                   static_cast<std::uint32_t>(static_cast<std::uint8_t>(data[3])) << 24;
+        }
+    }
+
+    // serializes the data into a flat binary snapshot: a header, fixed-size
+    // section and pair records with offsets, and a string table; the records
+    // keep the container's iteration order, so snapshots of the default
+    // (sorted) Data can be binary-searched
+    template <class DataType>
+    [[nodiscard]] std::vector<char> encodeBinary(const DataType& data)
+    {
+        std::vector<char> result;
+        result.insert(result.end(), binaryMagic.begin(), binaryMagic.end());
+
+        std::uint32_t sectionCount = 0;
+        std::uint32_t pairCount = 0;
+        std::size_t stringSize = 0;
+
+        for (const auto& [name, section] : data)
+        {
+            ++sectionCount;
+            stringSize += name.size();
+
+            for (const auto& [key, value] : section)
+            {
+                ++pairCount;
+                stringSize += key.size() + value.size();
+            }
+        }
+
+        writeUint32(result, sectionCount);
+
+        const auto sectionRecords = binaryMagic.size() + 4;
+        const auto pairRecords = sectionRecords + sectionCount * std::size_t{16};
+        auto stringOffset = pairRecords + pairCount * std::size_t{16};
+
+        std::vector<char> strings;
+        strings.reserve(stringSize);
+
+        const auto append = [&](const auto& string) {
+            writeUint32(result, static_cast<std::uint32_t>(stringOffset));
+            writeUint32(result, static_cast<std::uint32_t>(string.size()));
+            strings.insert(strings.end(), string.begin(), string.end());
+            stringOffset += string.size();
+        };
+
+        std::uint32_t firstPair = 0;
+
+        for (const auto& [name, section] : data)
+        {
+            append(name);
+            writeUint32(result, static_cast<std::uint32_t>(section.getSize()));
+            writeUint32(result, firstPair);
+            firstPair += static_cast<std::uint32_t>(section.getSize());
+        }
+
+        for (const auto& [name, section] : data)
+            for (const auto& [key, value] : section)
+            {
+                append(key);
+                append(value);
+            }
+
+        result.insert(result.end(), strings.begin(), strings.end());
+        return result;
+    }
+
+    inline namespace detail
+    {
+        // walks the snapshot records, invoking the section callback with the
+        // name and the pair callback with (sectionName, key, value), all as
+        // string_views into the buffer
+        template <class SectionCallback, class PairCallback>
+        void forEachBinaryEntry(const char* const begin, const char* const end,
+                                const SectionCallback& sectionCallback,
+                                const PairCallback& pairCallback)
+        {
+            const auto size = static_cast<std::size_t>(end - begin);
+
+            if (size < binaryMagic.size() + 4 ||
+                !std::equal(binaryMagic.begin(), binaryMagic.end(), begin))
+                throw ParseError{"Invalid binary data"};
+
+            const auto sectionCount = readUint32(begin + binaryMagic.size());
+            const auto sectionRecords = binaryMagic.size() + 4;
+            const auto pairRecords = sectionRecords + sectionCount * std::size_t{16};
+
+            if (pairRecords > size)
+                throw ParseError{"Invalid binary data"};
+
+            const auto string = [&](const char* const record) {
+                const auto offset = readUint32(record);
+                const auto length = readUint32(record + 4);
+
+                if (offset > size || length > size - offset)
+                    throw ParseError{"Invalid binary data"};
+
+                return std::string_view{begin + offset, length};
+            };
+
+            for (std::uint32_t section = 0; section < sectionCount; ++section)
+            {
+                const auto record = begin + sectionRecords + section * std::size_t{16};
+                const auto name = string(record);
+                const auto pairCount = readUint32(record + 8);
+                const auto firstPair = readUint32(record + 12);
+
+                if (pairRecords + (static_cast<std::size_t>(firstPair) + pairCount) * 16 > size)
+                    throw ParseError{"Invalid binary data"};
+
+                sectionCallback(name);
+
+                for (std::uint32_t pair = 0; pair < pairCount; ++pair)
+                {
+                    const auto pairRecord = begin + pairRecords + (firstPair + pair) * std::size_t{16};
+                    pairCallback(name, string(pairRecord), string(pairRecord + 8));
+                }
+            }
+        }
+    }
+
+    // loads a snapshot produced by encodeBinary into an owning Data
+    [[nodiscard]] inline Data parseBinary(const char* const begin, const char* const end)
+    {
+        Data result;
+        forEachBinaryEntry(begin, end,
+                           [&result](const std::string_view name) {
+                               result[name].clear();
+                           },
+                           [&result](const std::string_view name,
+                                     const std::string_view key,
+                                     const std::string_view value) {
+                               result[name][key] = value;
+                           });
+        return result;
+    }
+
+    // loads a snapshot without copying; the views point into the caller-owned
+    // buffer, which makes an mmap-ed snapshot usable without string allocation
+    [[nodiscard]] inline DataView parseBinaryView(const char* const begin, const char* const end)
+    {
+        DataView result;
+        forEachBinaryEntry(begin, end,
+                           [&result](const std::string_view name) {
+                               result[name] = SectionView{name};
+                           },
+                           [&result](const std::string_view name,
+                                     const std::string_view key,
+                                     const std::string_view value) {
+                               result[name][key] = value;
+                           });
+        return result;
+    }
+
+    // a copy-on-write layer over a shared base Data: unmodified sections are
+    // read through the base without being copied, and a section is privately
+    // materialized only on first write, so thousands of overlays can share
+    // one base tree
+    class OverlayData final
+    {
+    public:
+        explicit OverlayData(std::shared_ptr<const Data> initBase) noexcept:
+            base{std::move(initBase)}
+        {
+        }
+
+        [[nodiscard]] const std::shared_ptr<const Data>& getBase() const noexcept { return base; }
+        [[nodiscard]] const Data& getOverrides() const noexcept { return overrides; }
+
+        [[nodiscard]] bool hasSection(const std::string_view name) const
+        {
+            if (overrides.hasSection(name)) return true;
+            if (erased.find(name) != erased.end()) return false;
+            return base && base->hasSection(name);
+        }
+
+        // reads through to the shared base unless the section was overridden
+        [[nodiscard]] const Section& operator[](const std::string_view name) const
+        {
+            if (overrides.hasSection(name))
+                return overrides[name];
+
+            if (erased.find(name) == erased.end() && base && base->hasSection(name))
+                return (*base)[name];
+
+            throw RangeError{"Section does not exist"};
+        }
+
+        // materializes a private copy of the base section on first write
+        [[nodiscard]] Section& operator[](const std::string_view name)
+        {
+            if (!overrides.hasSection(name) &&
+                erased.find(name) == erased.end() &&
+                base && base->hasSection(name))
+                overrides[name] = (*base)[name];
+
+            erased.erase(std::string{name});
+            return overrides[name];
+        }
+
+        void eraseSection(const std::string_view name)
+        {
+            overrides.eraseSection(name);
+
+            if (base && base->hasSection(name))
+                erased.insert(std::string{name});
+        }
+
+        [[nodiscard]] std::size_t getSize() const
+        {
+            auto result = overrides.getSize();
+
+            if (base)
+                for (const auto& [name, section] : *base)
+                    if (!overrides.hasSection(name) && erased.find(name) == erased.end())
+                        ++result;
+
+            return result;
+        }
+
+        // merges the base and the overrides into an independent Data
+        [[nodiscard]] Data flatten() const
+        {
+            Data result;
+
+            if (base)
+                for (const auto& [name, section] : *base)
+                    if (erased.find(name) == erased.end())
+                        result[name] = section;
+
+            for (const auto& [name, section] : overrides)
+                result[name] = section;
+
+            return result;
+        }
+
+    private:
+        std::shared_ptr<const Data> base;
+        Data overrides;
+        std::set<std::string, std::less<>> erased;
+    };
+
+    // combines layered configurations (defaults, region, cluster, tenant)
+    // with last-layer-wins semantics in one ordered sweep over the sorted
+    // maps instead of a tree lookup per key per layer
+    [[nodiscard]] inline Data merge(const Data* const* const layers, const std::size_t layerCount)
+    {
+        Data result;
+
+        std::vector<decltype(layers[0]->begin())> sectionIterators;
+        sectionIterators.reserve(layerCount);
+        for (std::size_t layer = 0; layer < layerCount; ++layer)
+            sectionIterators.push_back(layers[layer]->begin());
+
+        std::vector<std::pair<std::string_view, std::string_view>> pairs;
+
+        for (;;)
+        {
+            // the smallest section name any layer still has
+            const std::string* sectionName = nullptr;
+            for (std::size_t layer = 0; layer < layerCount; ++layer)
+                if (sectionIterators[layer] != layers[layer]->end() &&
+                    (!sectionName || sectionIterators[layer]->first < *sectionName))
+                    sectionName = &sectionIterators[layer]->first;
+
+            if (!sectionName)
+                break;
+
+            std::vector<decltype(layers[0]->begin()->second.begin())> valueIterators;
+            std::vector<decltype(layers[0]->begin()->second.end())> valueEnds;
+
+            for (std::size_t layer = 0; layer < layerCount; ++layer)
+                if (sectionIterators[layer] != layers[layer]->end() &&
+                    sectionIterators[layer]->first == *sectionName)
+                {
+                    valueIterators.push_back(sectionIterators[layer]->second.begin());
+                    valueEnds.push_back(sectionIterators[layer]->second.end());
+                }
+
+            // merge the value maps of every layer that has the section; on a
+            // key collision the value of the last layer survives
+            pairs.clear();
+            for (;;)
+            {
+                const std::string* key = nullptr;
+                for (std::size_t layer = 0; layer < valueIterators.size(); ++layer)
+                    if (valueIterators[layer] != valueEnds[layer] &&
+                        (!key || valueIterators[layer]->first < *key))
+                        key = &valueIterators[layer]->first;
+
+                if (!key)
+                    break;
+
+                std::string_view value;
+                for (std::size_t layer = 0; layer < valueIterators.size(); ++layer)
+                    if (valueIterators[layer] != valueEnds[layer] &&
+                        valueIterators[layer]->first == *key)
+                        value = std::string_view{valueIterators[layer]++->second};
+
+                pairs.emplace_back(std::string_view{*key}, value);
+            }
+
+            auto& section = result[*sectionName];
+            section.insert(pairs.begin(), pairs.end());
+
+            const std::string name = *sectionName; // the owners advance next
+            for (std::size_t layer = 0; layer < layerCount; ++layer)
+                if (sectionIterators[layer] != layers[layer]->end() &&
+                    sectionIterators[layer]->first == name)
+                    ++sectionIterators[layer];
+        }
+
+        return result;
+    }
+
+    [[nodiscard]] inline Data merge(const std::initializer_list<const Data*> layers)
+    {
+        return merge(layers.begin(), layers.size());
+    }
+
+    // a push parser for data that arrives in chunks: feed consumes every
+    // complete line as it arrives and carries the current section and the
+    // partial line across chunk boundaries, so memory stays capped at one
+    // chunk plus one line instead of the whole payload
+    class ChunkParser final
+    {
+    public:
+        void feed(const std::string_view chunk)
+        {
+            pending += chunk;
+
+            if (!started)
+            {
+                const auto mark = reinterpret_cast<const char*>(utf8ByteOrderMark.data());
+                if (pending.size() < utf8ByteOrderMark.size() &&
+                    std::equal(pending.begin(), pending.end(), mark))
+                    return; // may still be a byte order mark prefix
+
+                if (hasByteOrderMark(pending.data(), pending.data() + pending.size()))
+                    pending.erase(0, utf8ByteOrderMark.size());
+
+                started = true;
+            }
+
+            // the last line may continue in the next chunk, keep it pending
+            const auto lastNewline = pending.find_last_of("\r\n");
+            if (lastNewline == std::string::npos)
+                return;
+
+            Builder builder{data, section};
+            parseEvents(pending.data(), pending.data() + lastNewline + 1, builder);
+            pending.erase(0, lastNewline + 1);
+        }
+
+        // consumes the unterminated final line and hands over the result,
+        // leaving the parser ready for the next stream
+        [[nodiscard]] Data finish()
+        {
+            if (!pending.empty())
+            {
+                Builder builder{data, section};
+                parseEvents(pending.data(), pending.data() + pending.size(), builder);
+                pending.clear();
+            }
+
+            section.clear();
+            started = false;
+
+            Data result = std::move(data);
+            data = Data{};
+            return result;
+        }
+
+    private:
+        class Builder final
+        {
+        public:
+            Builder(Data& initResult, std::string& initSection) noexcept:
+                cursor{initResult.makeCursor()}, section{initSection}
+            {
+            }
+
+            void onSection(const std::string_view name)
+            {
+                section = name;
+                cursor[section].clear();
+            }
+
+            void onKeyValue(const std::string_view key, const std::string_view value)
+            {
+                cursor[section][key] = value;
+            }
+
+            void onComment(std::string_view) noexcept
+            {
+            }
+
+        private:
+            Data::Cursor cursor;
+            std::string& section;
+        };
+
+        Data data;
+        std::string section; // survives between chunks
+        std::string pending; // the partial trailing line
+        bool started = false;
+    };
+
+    // re-parses hot-reloaded buffers at section granularity: every section's
+    // text span is hashed, and only sections whose bytes actually changed are
+    // rebuilt; unchanged sections keep their existing map nodes
+    class IncrementalParser final
+    {
+    public:
+        [[nodiscard]] const Data& getData() const noexcept { return data; }
+
+        // returns the number of sections that were rebuilt; if a changed
+        // section fails to parse, the previously parsed sections are kept
+        std::size_t update(const char* begin, const char* end)
+        {
+            if (hasByteOrderMark(begin, end))
+                begin += utf8ByteOrderMark.size();
+
+            std::size_t rebuilt = 0;
+
+            // every occurrence of a name is hashed separately, so a
+            // re-declared section in a concatenated bundle cannot alias two
+            // segments into one entry; only the last segment carries the
+            // section's effective content, exactly as in a serial parse
+            struct Segments final
+            {
+                std::vector<std::uint64_t> hashes;
+                const char* lastBegin = nullptr;
+                const char* lastEnd = nullptr;
+            };
+            std::map<std::string, Segments, std::less<>> segments;
+
+            auto segmentBegin = begin;
+            std::string_view segmentName;
+
+            const auto flush = [&](const char* const segmentEnd) {
+                if (segmentBegin == segmentEnd && segmentName.empty())
+                    return; // nothing before the first section
+
+                auto& occurrences = segments[std::string{segmentName}];
+                occurrences.hashes.push_back(hashBytes(segmentBegin, segmentEnd));
+                occurrences.lastBegin = segmentBegin;
+                occurrences.lastEnd = segmentEnd;
+            };
+
+            for (auto iterator = begin; iterator != end;)
+            {
+                auto lineStart = iterator;
+                while (iterator != end && isWhiteSpace(*iterator))
+                    ++iterator;
+
+                if (iterator != end && *iterator == '[') // a section header starts a new segment
+                {
+                    flush(lineStart);
+                    segmentBegin = lineStart;
+
+                    const auto nameBegin = iterator + 1;
+                    const auto nameEnd = findDelimiter(nameBegin, end, ']', ';', '\r', '\n');
+                    segmentName = trim(std::string_view{nameBegin, static_cast<std::size_t>(nameEnd - nameBegin)});
+                }
+
+                iterator = findDelimiter(iterator, end, '\r', '\n', '\r', '\n');
+                if (iterator != end)
+                    ++iterator; // skip the newline
+            }
+
+            flush(end);
+
+            for (const auto& [name, occurrences] : segments)
+                if (const auto iterator = hashes.find(name);
+                    iterator == hashes.end() || iterator->second != occurrences.hashes)
+                {
+                    Data fresh = parse(occurrences.lastBegin, occurrences.lastEnd);
+
+                    if (fresh.hasSection(name))
+                        data[name] = std::move(fresh[name]);
+                    else
+                        data.eraseSection(name);
+
+                    ++rebuilt;
+                }
+
+            // drop sections that are no longer present in the input
+            std::vector<std::string> removed;
+            for (const auto& [name, section] : data)
+                if (segments.find(name) == segments.end())
+                    removed.push_back(name);
+
+            for (const auto& name : removed)
+                data.eraseSection(name);
+
+            hashes.clear();
+            for (auto& [name, occurrences] : segments)
+                hashes.emplace(name, std::move(occurrences.hashes));
+
+            return rebuilt;
+        }
+
+        std::size_t update(const std::string_view input)
+        {
+            return update(input.data(), input.data() + input.size());
+        }
+
+    private:
+        Data data;
+        // one hash per occurrence of the section, in file order
+        std::map<std::string, std::vector<std::uint64_t>, std::less<>> hashes;
+    };
+
+    // indexes section byte ranges in a caller-owned buffer and parses a
+    // section body only on first access, so reading a couple of keys out of a
+    // file with hundreds of sections skips the work for all the others
+    class LazyData final
+    {
+    public:
+        LazyData(const char* const initBegin, const char* const initEnd):
+            begin{initBegin}, end{initEnd}
+        {
+            if (hasByteOrderMark(begin, end))
+                begin += utf8ByteOrderMark.size();
+
+            auto segmentBegin = begin;
+            std::string_view segmentName;
+
+            const auto flush = [this, &segmentBegin, &segmentName](const char* const segmentEnd) {
+                if (segmentBegin != segmentEnd || !segmentName.empty())
+                    index.insert_or_assign(std::string{segmentName}, Range{segmentBegin, segmentEnd});
+            };
+
+            for (auto iterator = begin; iterator != end;)
+            {
+                auto lineStart = iterator;
+                while (iterator != end && isWhiteSpace(*iterator))
+                    ++iterator;
+
+                if (iterator != end && *iterator == '[') // a section header starts a new range
+                {
+                    flush(lineStart);
+                    segmentBegin = lineStart;
+
+                    const auto nameBegin = iterator + 1;
+                    const auto nameEnd = findDelimiter(nameBegin, end, ']', ';', '\r', '\n');
+                    segmentName = trim(std::string_view{nameBegin, static_cast<std::size_t>(nameEnd - nameBegin)});
+                }
+
+                iterator = findDelimiter(iterator, end, '\r', '\n', '\r', '\n');
+                if (iterator != end)
+                    ++iterator; // skip the newline
+            }
+
+            flush(end);
+        }
+
+        [[nodiscard]] bool hasSection(const std::string_view name) const
+        {
+            return index.find(name) != index.end();
+        }
+
+        // parses the section body on first access and caches the result
+        [[nodiscard]] const Section& operator[](const std::string_view name) const
+        {
+            if (const auto materialized = sections.find(name); materialized != sections.end())
+                return materialized->second;
+
+            const auto range = index.find(name);
+            if (range == index.end())
+                throw RangeError{"Section does not exist"};
+
+            Data fresh = parse(range->second.begin, range->second.end);
+            return sections.try_emplace(std::string{name}, std::move(fresh[name])).first->second;
+        }
+
+        [[nodiscard]] std::size_t getSize() const noexcept { return index.size(); }
+        [[nodiscard]] std::size_t getMaterializedCount() const noexcept { return sections.size(); }
+
+    private:
+        struct Range final
+        {
+            const char* begin;
+            const char* end;
+        };
+
+        const char* begin;
+        const char* end;
+        std::map<std::string, Range, std::less<>> index;
+        mutable std::map<std::string, Section, std::less<>> sections;
+    };
+
+    // the index points into the caller-owned buffer, which must stay alive
+    [[nodiscard]] inline LazyData parseLazy(const char* begin, const char* end)
+    {
+        return LazyData{begin, end};
+    }
+
+    [[nodiscard]] inline LazyData parseLazy(const char* data)
+    {
+        return LazyData{data, data + std::strlen(data)};
+    }
+
+    [[nodiscard]] inline LazyData parseLazy(const std::string_view data)
+    {
+        return LazyData{data.data(), data.data() + data.size()};
+    }
+
+    // a read-only repacking of a parsed tree: every string lives in one
+    // contiguous pool and sections and pairs become sorted arrays of offsets,
+    // which drops the per-node map overhead and makes lookups binary searches
+    // over cache-friendly storage
+    class FrozenData final
+    {
+    public:
+        class FrozenSection final
+        {
+        public:
+            FrozenSection(const FrozenData& initData, const std::size_t initSection) noexcept:
+                data{initData}, section{initSection}
+            {
+            }
+
+            [[nodiscard]] std::string_view getName() const noexcept
+            {
+                return data.view(data.sections[section].nameOffset, data.sections[section].nameLength);
+            }
+
+            [[nodiscard]] bool hasValue(const std::string_view key) const noexcept
+            {
+                return findPair(key) != data.sections[section].pairCount;
+            }
+
+            [[nodiscard]] std::string_view operator[](const std::string_view key) const
+            {
+                const auto pair = findPair(key);
+                if (pair == data.sections[section].pairCount)
+                    throw RangeError{"Value does not exist"};
+
+                const auto& entry = data.pairs[data.sections[section].firstPair + pair];
+                return data.view(entry.valueOffset, entry.valueLength);
+            }
+
+            [[nodiscard]] std::string_view getValue(const std::string_view key,
+                                                    const std::string_view defaultValue = {}) const noexcept
+            {
+                const auto pair = findPair(key);
+                if (pair == data.sections[section].pairCount)
+                    return defaultValue;
+
+                const auto& entry = data.pairs[data.sections[section].firstPair + pair];
+                return data.view(entry.valueOffset, entry.valueLength);
+            }
+
+            [[nodiscard]] std::size_t getSize() const noexcept
+            {
+                return data.sections[section].pairCount;
+            }
+
+        private:
+            // binary-searches the sorted pair range of the section
+            [[nodiscard]] std::size_t findPair(const std::string_view key) const noexcept
+            {
+                const auto& entry = data.sections[section];
+                std::size_t low = 0;
+                auto high = static_cast<std::size_t>(entry.pairCount);
+
+                while (low < high)
+                {
+                    const auto middle = low + (high - low) / 2;
+                    const auto& pair = data.pairs[entry.firstPair + middle];
+                    const auto middleKey = data.view(pair.keyOffset, pair.keyLength);
+
+                    if (middleKey < key)
+                        low = middle + 1;
+                    else if (key < middleKey)
+                        high = middle;
+                    else
+                        return middle;
+                }
+
+                return entry.pairCount;
+            }
+
+            const FrozenData& data;
+            std::size_t section;
+        };
+
+        template <class DataType>
+        explicit FrozenData(const DataType& data)
+        {
+            std::size_t poolSize = 0;
+            for (const auto& [name, section] : data)
+            {
+                poolSize += name.size();
+                for (const auto& [key, value] : section)
+                    poolSize += key.size() + value.size();
+            }
+
+            pool.reserve(poolSize);
+
+            for (const auto& [name, section] : data)
+            {
+                SectionEntry entry;
+                entry.nameOffset = append(name);
+                entry.nameLength = static_cast<std::uint32_t>(name.size());
+                entry.firstPair = static_cast<std::uint32_t>(pairs.size());
+                entry.pairCount = static_cast<std::uint32_t>(section.getSize());
+
+                for (const auto& [key, value] : section)
+                {
+                    PairEntry pair;
+                    pair.keyOffset = append(key);
+                    pair.keyLength = static_cast<std::uint32_t>(key.size());
+                    pair.valueOffset = append(value);
+                    pair.valueLength = static_cast<std::uint32_t>(value.size());
+                    pairs.push_back(pair);
+                }
+
+                // unordered sources arrive unsorted, the searches need order
+                std::sort(pairs.begin() + entry.firstPair, pairs.end(),
+                          [this](const PairEntry& first, const PairEntry& second) noexcept {
+                              return view(first.keyOffset, first.keyLength) <
+                                  view(second.keyOffset, second.keyLength);
+                          });
+
+                sections.push_back(entry);
+            }
+
+            std::sort(sections.begin(), sections.end(),
+                      [this](const SectionEntry& first, const SectionEntry& second) noexcept {
+                          return view(first.nameOffset, first.nameLength) <
+                              view(second.nameOffset, second.nameLength);
+                      });
+        }
+
+        [[nodiscard]] bool hasSection(const std::string_view name) const noexcept
+        {
+            return findSection(name) != sections.size();
+        }
+
+        [[nodiscard]] FrozenSection operator[](const std::string_view name) const
+        {
+            const auto section = findSection(name);
+            if (section == sections.size())
+                throw RangeError{"Section does not exist"};
+
+            return FrozenSection{*this, section};
+        }
+
+        [[nodiscard]] std::size_t getSize() const noexcept { return sections.size(); }
+
+    private:
+        struct SectionEntry final
+        {
+            std::uint32_t nameOffset;
+            std::uint32_t nameLength;
+            std::uint32_t firstPair;
+            std::uint32_t pairCount;
+        };
+
+        struct PairEntry final
+        {
+            std::uint32_t keyOffset;
+            std::uint32_t keyLength;
+            std::uint32_t valueOffset;
+            std::uint32_t valueLength;
+        };
+
+        [[nodiscard]] std::string_view view(const std::uint32_t offset, const std::uint32_t length) const noexcept
+        {
+            return std::string_view{pool.data() + offset, length};
+        }
+
+        [[nodiscard]] std::uint32_t append(const std::string_view string)
+        {
+            const auto offset = static_cast<std::uint32_t>(pool.size());
+            pool.append(string);
+            return offset;
+        }
+
+        [[nodiscard]] std::size_t findSection(const std::string_view name) const noexcept
+        {
+            std::size_t low = 0;
+            auto high = sections.size();
+
+            while (low < high)
+            {
+                const auto middle = low + (high - low) / 2;
+                const auto middleName = view(sections[middle].nameOffset, sections[middle].nameLength);
+
+                if (middleName < name)
+                    low = middle + 1;
+                else if (name < middleName)
+                    high = middle;
+                else
+                    return middle;
+            }
+
+            return sections.size();
+        }
+
+        std::string pool;
+        std::vector<SectionEntry> sections;
+        std::vector<PairEntry> pairs;
+    };
+
+    // repacks a read-mostly tree into its frozen form
+    template <class DataType>
+    [[nodiscard]] FrozenData freeze(const DataType& data)
+    {
+        return FrozenData{data};
+    }
+
+    // computes the exact number of bytes encode would produce
+    template <class DataType>
+    [[nodiscard]] std::size_t encodedSize(const DataType& data, const bool byteOrderMark = false) noexcept
+    {
+        auto result = byteOrderMark ? utf8ByteOrderMark.size() : 0;
+
+        for (const auto& [name, section] : data)
+        {
+            if (!name.empty())
+                result += name.size() + 3; // brackets and newline
+
+            for (const auto& [key, value] : section)
+                result += key.size() + value.size() + 2; // equals sign and newline
+        }
+
+        return result;
+    }
+
+    inline namespace detail
+    {
+        // feeds the encoded pieces to the sink, a callable taking a string_view
+        template <class DataType, class Sink>
+        void encodePieces(const DataType& data, const Sink& write, const bool byteOrderMark)
+        {
+            if (byteOrderMark)
+                write(std::string_view{reinterpret_cast<const char*>(utf8ByteOrderMark.data()),
+                                       utf8ByteOrderMark.size()});
+
+            for (const auto& [name, section] : data)
+            {
+                if (!name.empty())
+                {
+                    write(std::string_view{"["});
+                    write(std::string_view{name});
+                    write(std::string_view{"]\n"});
+                }
+
+                for (const auto& [key, value] : section)
+                {
+                    write(std::string_view{key});
+                    write(std::string_view{"="});
+                    write(std::string_view{value});
+                    write(std::string_view{"\n"});
+                }
+            }
+        }
+
+        // writes the encoded data to the output, which must have room for
+        // encodedSize(data, byteOrderMark) bytes
+        template <class DataType>
+        char* encodeUnchecked(const DataType& data, char* output, const bool byteOrderMark) noexcept
+        {
+            encodePieces(data, [&output](const std::string_view piece) noexcept {
+                std::memcpy(output, piece.data(), piece.size());
+                output += piece.size();
+            }, byteOrderMark);
+
+            return output;
+        }
+    }
+
+    template <class DataType>
+    [[nodiscard]] std::string encode(const DataType& data, const bool byteOrderMark = false)
+    {
+        std::string result;
+        result.resize(encodedSize(data, byteOrderMark));
+        encodeUnchecked(data, result.data(), byteOrderMark);
+        return result;
+    }
+
+    // encodes straight into the caller-owned buffer and returns the number of
+    // bytes written
+    template <class DataType>
+    std::size_t encode(const DataType& data, char* output, const std::size_t capacity,
+                       const bool byteOrderMark = false)
+    {
+        const auto size = encodedSize(data, byteOrderMark);
+
+        if (size > capacity)
+            throw RangeError{"Output buffer is too small"};
+
+        encodeUnchecked(data, output, byteOrderMark);
+        return size;
+    }
+
+    // streams the encoded text into an output iterator without materializing it
+    // raw pointers are excluded so this cannot collide with the bounded
+    // buffer overload above; an unbounded write through a char* should go
+    // through encode(data, output, capacity) anyway
+    template <class DataType, class OutputIterator,
+              std::enable_if_t<!std::is_base_of_v<std::ostream, OutputIterator> &&
+                               !std::is_pointer_v<OutputIterator>, int> = 0>
+    OutputIterator encode(const DataType& data, OutputIterator output, const bool byteOrderMark = false)
+    {
+        encodePieces(data, [&output](const std::string_view piece) {
+            output = std::copy(piece.begin(), piece.end(), output);
+        }, byteOrderMark);
+
+        return output;
+    }
+
+    // streams the encoded text to the stream with internal buffering, so the
+    // full text never has to be held in memory
+    template <class DataType>
+    std::ostream& encode(const DataType& data, std::ostream& stream, const bool byteOrderMark = false)
+    {
+        constexpr std::size_t bufferSize = 65536;
+
+        std::string buffer;
+        buffer.reserve(bufferSize);
+
+        encodePieces(data, [&](const std::string_view piece) {
+            if (buffer.size() + piece.size() > bufferSize)
+            {
+                stream.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+                buffer.clear();
+            }
+
+            if (piece.size() > bufferSize)
+                stream.write(piece.data(), static_cast<std::streamsize>(piece.size()));
+            else
+                buffer.append(piece);
+        }, byteOrderMark);
+
+        if (!buffer.empty())
+            stream.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+
+        return stream;
+    }
+
+    // caches the encoded text of one Data between sync cycles: section
+    // versions reveal what changed, unchanged sections reuse their retained
+    // fragment and a fully unchanged tree returns the previous encoding
+    // without touching it
+    class EncodeCache final
+    {
+    public:
+        [[nodiscard]] const std::string& encode(const Data& data, const bool byteOrderMark = false)
+        {
+            auto changed = !valid || byteOrderMark != cachedByteOrderMark;
+            std::size_t seen = 0;
+
+            for (const auto& [name, section] : data)
+            {
+                ++seen;
+                const auto iterator = fragments.find(name);
+
+                if (iterator != fragments.end() && iterator->second.version == section.getVersion())
+                    continue;
+
+                auto& fragment = iterator != fragments.end()
+                    ? iterator->second
+                    : fragments.try_emplace(name).first->second;
+
+                fragment.version = section.getVersion();
+                fragment.text.clear();
+
+                if (!name.empty())
+                {
+                    fragment.text += '[';
+                    fragment.text += name;
+                    fragment.text += "]\n";
+                }
+
+                for (const auto& [key, value] : section)
+                {
+                    fragment.text += key;
+                    fragment.text += '=';
+                    fragment.text += value;
+                    fragment.text += '\n';
+                }
+
+                changed = true;
+            }
+
+            if (fragments.size() != seen) // some sections were removed
+            {
+                for (auto iterator = fragments.begin(); iterator != fragments.end();)
+                    if (!data.hasSection(iterator->first))
+                        iterator = fragments.erase(iterator);
+                    else
+                        ++iterator;
+
+                changed = true;
+            }
+
+            if (changed)
+            {
+                cached.clear();
+
+                if (byteOrderMark)
+                    cached.append(reinterpret_cast<const char*>(utf8ByteOrderMark.data()),
+                                  utf8ByteOrderMark.size());
+
+                for (const auto& [name, section] : data)
+                    cached += fragments.find(name)->second.text;
+
+                cachedByteOrderMark = byteOrderMark;
+                valid = true;
+            }
+
+            return cached;
+        }
+
+        void invalidate() noexcept
+        {
+            valid = false;
+            fragments.clear();
+        }
+
+    private:
+        struct Fragment final
+        {
+            std::uint64_t version = 0;
+            std::string text;
+        };
+
+        std::map<std::string, Fragment, std::less<>> fragments;
+        std::string cached;
+        bool cachedByteOrderMark = false;
+        bool valid = false;
+    };
 } // namespace ini
 
 #endif // INI_HPP
@@ -0,0 +1,128 @@
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <string>
+#include "ini.hpp"
+
+namespace
+{
+    // keeps the compiler from discarding a result-only workload
+    template <class T>
+    void doNotOptimize(const T& value)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : "g"(&value) : "memory");
+#else
+        static volatile const void* sink;
+        sink = &value;
+#endif
+    }
+
+    // runs the workload repeatedly and reports the best observed time, which
+    // is the least noisy estimate on a shared machine
+    template <class Workload>
+    void run(const char* const name, const std::size_t bytes, const Workload& workload)
+    {
+        using Clock = std::chrono::steady_clock;
+
+        constexpr int repeats = 5;
+        auto best = std::chrono::nanoseconds::max();
+        std::size_t iterations = 1;
+
+        // grow the iteration count until one measurement takes long enough
+        for (;;)
+        {
+            const auto start = Clock::now();
+            for (std::size_t i = 0; i < iterations; ++i)
+                doNotOptimize(workload());
+            const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start);
+
+            if (elapsed >= std::chrono::milliseconds{10} || iterations >= 100000000)
+            {
+                best = std::max(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed / iterations),
+                                std::chrono::nanoseconds{1});
+                break;
+            }
+
+            iterations *= 10;
+        }
+
+        for (int repeat = 1; repeat < repeats; ++repeat)
+        {
+            const auto start = Clock::now();
+            for (std::size_t i = 0; i < iterations; ++i)
+                doNotOptimize(workload());
+            const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>((Clock::now() - start) / iterations);
+
+            if (elapsed < best) best = elapsed;
+        }
+
+        if (bytes != 0)
+            std::printf("%-32s %12lld ns/op %10.1f MB/s\n", name,
+                        static_cast<long long>(best.count()),
+                        static_cast<double>(bytes) * 1000.0 / static_cast<double>(best.count()));
+        else
+            std::printf("%-32s %12lld ns/op\n", name,
+                        static_cast<long long>(best.count()));
+    }
+
+    [[nodiscard]] std::string makeInput(const std::size_t sections, const std::size_t keysPerSection,
+                                        const bool comments)
+    {
+        std::string result;
+
+        for (std::size_t section = 0; section < sections; ++section)
+        {
+            if (comments) result += "; section comment\n";
+            result += "[section" + std::to_string(section) + "]\n";
+
+            for (std::size_t key = 0; key < keysPerSection; ++key)
+            {
+                result += "key" + std::to_string(key) + " = some value " + std::to_string(key);
+                if (comments) result += " ; trailing comment";
+                result += '\n';
+            }
+        }
+
+        return result;
+    }
+}
+
+int main()
+{
+    const auto small = makeInput(2, 10, false);
+    const auto large = makeInput(500, 100, false);
+    const auto commentHeavy = makeInput(500, 100, true);
+
+    run("parse/small", small.size(), [&] { return ini::parse(small); });
+    run("parse/large", large.size(), [&] { return ini::parse(large); });
+    run("parse/comment-heavy", commentHeavy.size(), [&] { return ini::parse(commentHeavy); });
+    run("parseView/large", large.size(), [&] { return ini::parseView(large); });
+
+    ini::Arena arena;
+    run("parse/arena-large", large.size(), [&] {
+        arena.reset();
+        return ini::parse(large.data(), large.data() + large.size(), arena);
+    });
+
+    const auto lookupData = ini::parse(large);
+    const auto& lookupSection = lookupData["section250"];
+    run("section-lookup", 0, [&] {
+        std::size_t hits = 0;
+        for (std::size_t key = 0; key < 100; ++key)
+            hits += lookupSection.hasValue("key" + std::to_string(key % 100));
+        return hits;
+    });
+
+    const auto wide = ini::parse(makeInput(1, 10000, false));
+    const auto deep = ini::parse(makeInput(10000, 2, false));
+    run("encode/wide", ini::encodedSize(wide), [&] { return ini::encode(wide); });
+    run("encode/deep", ini::encodedSize(deep), [&] { return ini::encode(deep); });
+
+    const std::string bom = "\xEF\xBB\xBFkey=value";
+    run("byte-order-mark", 0, [&] {
+        return ini::hasByteOrderMark(bom.data(), bom.data() + bom.size());
+    });
+
+    return 0;
+}
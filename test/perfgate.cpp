@@ -0,0 +1,104 @@
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <string>
+#include "ini.hpp"
+
+// a corpus-driven throughput gate: every pathological input must stay within
+// a fixed factor of the plain-input parse throughput on the same machine, so
+// a correct but slow parser change fails the build instead of shipping
+namespace
+{
+    // keeps the compiler from discarding a result-only workload
+    template <class T>
+    void doNotOptimize(const T& value)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : "g"(&value) : "memory");
+#else
+        static volatile const void* sink;
+        sink = &value;
+#endif
+    }
+
+    // best observed parse throughput in megabytes per second
+    [[nodiscard]] double throughput(const std::string& input)
+    {
+        using Clock = std::chrono::steady_clock;
+
+        constexpr int repeats = 5;
+        auto best = std::chrono::nanoseconds::max();
+
+        for (int repeat = 0; repeat < repeats; ++repeat)
+        {
+            const auto start = Clock::now();
+            doNotOptimize(ini::parse(input));
+            const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start);
+
+            if (elapsed < best) best = elapsed;
+        }
+
+        if (best.count() < 1) best = std::chrono::nanoseconds{1};
+
+        return static_cast<double>(input.size()) * 1000.0 / static_cast<double>(best.count());
+    }
+
+    [[nodiscard]] std::string makePlain()
+    {
+        std::string result;
+        for (std::size_t section = 0; section < 200; ++section)
+        {
+            result += "[section" + std::to_string(section) + "]\n";
+            for (std::size_t key = 0; key < 50; ++key)
+                result += "key" + std::to_string(key) + "=value" + std::to_string(key) + '\n';
+        }
+        return result;
+    }
+
+    bool gate(const char* const name, const std::string& input,
+              const double baseline, const double minimumRatio)
+    {
+        const auto speed = throughput(input);
+        const auto ratio = speed / baseline;
+        const auto passed = ratio >= minimumRatio;
+
+        std::printf("%-24s %10.1f MB/s %6.2fx of plain (minimum %.2fx) %s\n",
+                    name, speed, ratio, minimumRatio, passed ? "ok" : "FAILED");
+        return passed;
+    }
+}
+
+int main()
+{
+    const auto plain = makePlain();
+    const auto baseline = throughput(plain);
+    std::printf("%-24s %10.1f MB/s\n", "plain", baseline);
+
+    // the corpus distills inputs that fuzzing and production incidents have
+    // shown to stress a particular code path
+    std::string commentFlood;
+    for (std::size_t line = 0; line < 200000; ++line)
+        commentFlood += "; a comment line that carries no data at all\n";
+
+    std::string megaValue = "[s]\nkey=";
+    megaValue.append(8 * 1024 * 1024, 'x');
+    megaValue += '\n';
+
+    std::string sectionFlood;
+    for (std::size_t section = 0; section < 100000; ++section)
+        sectionFlood += "[section" + std::to_string(section) + "]\n";
+
+    const std::string blankFlood(4 * 1024 * 1024, '\n');
+
+    bool passed = true;
+    passed &= gate("comment-flood", commentFlood, baseline, 0.25);
+    passed &= gate("mega-value", megaValue, baseline, 0.50);
+    passed &= gate("section-flood", sectionFlood, baseline, 0.05);
+    passed &= gate("blank-flood", blankFlood, baseline, 0.50);
+
+    // a byte-order-mark-only file must parse to an empty tree without cost
+    const std::string bomOnly = "\xEF\xBB\xBF";
+    doNotOptimize(ini::parse(bomOnly));
+
+    return passed ? 0 : 1;
+}
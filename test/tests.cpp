@@ -1,4 +1,11 @@
+#include <array>
 #include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <deque>
+#include <sstream>
+#include <utility>
 #include <vector>
 #include "catch2/catch.hpp"
 #include "ini.hpp"
@@ -176,3 +183,776 @@ TEST_CASE("Invalid value")
 
     REQUIRE_THROWS_AS(constSection["a"], ini::RangeError);
 }
+
+TEST_CASE("View parsing", "[decoding]")
+{
+    const std::string source = "  ;test\n[s];aa\na = b; bb\nc=d\n";
+    const ini::DataView d = ini::parseView(source);
+    REQUIRE(d.getSize() == 1);
+    REQUIRE(d.hasSection("s"));
+    REQUIRE(d["s"].getSize() == 2);
+    REQUIRE(d["s"].hasValue("a"));
+    REQUIRE(d["s"]["a"] == "b");
+    REQUIRE(d["s"]["c"] == "d");
+    REQUIRE(d["s"]["a"].data() >= source.data());
+    REQUIRE(d["s"]["a"].data() < source.data() + source.size());
+}
+
+TEST_CASE("View parsing errors", "[decoding]")
+{
+    REQUIRE_THROWS_AS(ini::parseView("[s\na=b"), ini::ParseError);
+    REQUIRE_THROWS_AS(ini::parseView("[ ]\n"), ini::ParseError);
+    REQUIRE_THROWS_AS(ini::parseView("=b\n"), ini::ParseError);
+    REQUIRE_THROWS_AS(ini::parseView("a=b=c\n"), ini::ParseError);
+    REQUIRE_THROWS_AS(ini::parseView("[s] x\n"), ini::ParseError);
+}
+
+TEST_CASE("Multiple sections", "[decoding]")
+{
+    const ini::Data d = ini::parse("[a]\nx=1\n[b]\ny=2\n[a]\nz=3");
+    REQUIRE(d.getSize() == 2);
+    REQUIRE(d.hasSection("a"));
+    REQUIRE(d.hasSection("b"));
+    REQUIRE(d["a"].getSize() == 1);
+    REQUIRE(d["a"]["z"] == "3");
+    REQUIRE(d["b"]["y"] == "2");
+}
+
+TEST_CASE("Delimiter scanning", "[parsing]")
+{
+    const std::string padding(100, 'x');
+
+    for (const char delimiter : {'\n', '=', ';', '['})
+        for (std::size_t position = 0; position < padding.size(); ++position)
+        {
+            std::string s = padding;
+            s[position] = delimiter;
+
+            const auto result = ini::findDelimiter(s.data(), s.data() + s.size(),
+                                                   '\n', '=', ';', '[');
+            REQUIRE(result == s.data() + position);
+        }
+
+    const auto result = ini::findDelimiter(padding.data(), padding.data() + padding.size(),
+                                           '\n', '=', ';', '[');
+    REQUIRE(result == padding.data() + padding.size());
+}
+
+TEST_CASE("Unordered containers", "[container]")
+{
+    ini::UnorderedData data;
+    data["s"]["a"] = "1";
+    data["s"]["b"] = "2";
+
+    REQUIRE(data.getSize() == 1);
+    REQUIRE(data.hasSection("s"));
+    REQUIRE(data["s"].hasValue("a"));
+    REQUIRE(data["s"]["a"] == "1");
+    REQUIRE(data["s"].getValue("c", "d") == "d");
+
+    data["s"].deleteValue("a");
+    REQUIRE(!data["s"].hasValue("a"));
+
+    data.eraseSection("s");
+    REQUIRE(data.getSize() == 0);
+}
+
+TEST_CASE("Arena parsing", "[arena]")
+{
+    ini::Arena arena;
+
+    {
+        const std::string source = "[s]\na=b\nc=d\n";
+        const ini::ArenaData d = ini::parse(source.data(), source.data() + source.size(), arena);
+        REQUIRE(d.getSize() == 1);
+        REQUIRE(d.hasSection("s"));
+        REQUIRE(d["s"].getSize() == 2);
+        REQUIRE(d["s"]["a"] == "b");
+        REQUIRE(d["s"]["c"] == "d");
+    }
+
+    const auto capacity = arena.getCapacity();
+    arena.reset();
+
+    {
+        const std::string source = "[t]\ne=f\n";
+        const ini::ArenaData d = ini::parse(source.data(), source.data() + source.size(), arena);
+        REQUIRE(d["t"]["e"] == "f");
+    }
+
+    REQUIRE(arena.getCapacity() == capacity); // the reset arena was reused
+}
+
+TEST_CASE("Event parsing", "[events]")
+{
+    class Recorder final
+    {
+    public:
+        void onSection(const std::string_view name)
+        {
+            events.push_back("section:" + std::string{name});
+        }
+
+        void onKeyValue(const std::string_view key, const std::string_view value)
+        {
+            events.push_back("pair:" + std::string{key} + "=" + std::string{value});
+        }
+
+        void onComment(const std::string_view text)
+        {
+            events.push_back("comment:" + std::string{text});
+        }
+
+        std::vector<std::string> events;
+    };
+
+    Recorder recorder;
+    ini::parseEvents(";top\n[s] ;side\na=b;tail\nc=d\n", recorder);
+
+    REQUIRE(recorder.events == std::vector<std::string>{
+        "comment:top", "section:s", "comment:side",
+        "pair:a=b", "comment:tail", "pair:c=d"});
+}
+
+TEST_CASE("File parsing", "[file]")
+{
+    const auto path = std::filesystem::temp_directory_path() / "ini_test.ini";
+
+    {
+        std::ofstream file{path, std::ios::binary};
+        file << "[s]\na=b\n";
+    }
+
+    const ini::Data d = ini::parseFile(path);
+    REQUIRE(d["s"]["a"] == "b");
+
+    {
+        const ini::FileMapping mapping{path};
+        const ini::DataView view = ini::parseView(mapping.getView());
+        REQUIRE(view["s"]["a"] == "b");
+    }
+
+    std::filesystem::remove(path);
+
+    REQUIRE_THROWS_AS(ini::parseFile(path), ini::FileError);
+}
+
+TEST_CASE("Parsing many files", "[file]")
+{
+    const auto directory = std::filesystem::temp_directory_path();
+    std::vector<std::filesystem::path> paths;
+
+    for (int i = 0; i < 16; ++i)
+    {
+        paths.push_back(directory / ("ini_test_" + std::to_string(i) + ".ini"));
+        std::ofstream file{paths.back(), std::ios::binary};
+        file << "[s]\na=" << i << "\n";
+    }
+
+    const auto results = ini::parseMany(paths);
+    REQUIRE(results.size() == paths.size());
+
+    for (std::size_t i = 0; i < results.size(); ++i)
+        REQUIRE(results[i]["s"]["a"] == std::to_string(i));
+
+    for (const auto& path : paths)
+        std::filesystem::remove(path);
+
+    REQUIRE_THROWS_AS(ini::parseMany(paths), ini::FileError);
+}
+
+TEST_CASE("Trimming", "[decoding]")
+{
+    const ini::Data d = ini::parse("[ s ]\n  a b  =  c d  \n");
+    REQUIRE(d.hasSection("s"));
+    REQUIRE(d["s"]["a b"] == "c d");
+}
+
+TEST_CASE("Encoded size", "[encoding]")
+{
+    ini::Data d;
+    d["foo"]["a"] = "a";
+    d[""]["b"] = "bb";
+
+    REQUIRE(ini::encodedSize(d) == ini::encode(d).size());
+    REQUIRE(ini::encodedSize(d, true) == ini::encode(d, true).size());
+}
+
+TEST_CASE("Buffer encoding", "[encoding]")
+{
+    ini::Data d;
+    d["foo"]["a"] = "a";
+
+    std::array<char, 64> buffer;
+    const auto size = ini::encode(d, buffer.data(), buffer.size());
+    REQUIRE(std::string(buffer.data(), size) == "[foo]\na=a\n");
+
+    std::array<char, 4> small;
+    REQUIRE_THROWS_AS(ini::encode(d, small.data(), small.size()), ini::RangeError);
+}
+
+TEST_CASE("Incremental parsing", "[incremental]")
+{
+    ini::IncrementalParser parser;
+
+    REQUIRE(parser.update("top=1\n[a]\nx=1\n[b]\ny=2\n") == 3);
+    REQUIRE(parser.getData()[""]["top"] == "1");
+    REQUIRE(parser.getData()["a"]["x"] == "1");
+    REQUIRE(parser.getData()["b"]["y"] == "2");
+
+    REQUIRE(parser.update("top=1\n[a]\nx=1\n[b]\ny=2\n") == 0); // unchanged
+
+    REQUIRE(parser.update("top=1\n[a]\nx=9\n[b]\ny=2\n") == 1); // one section changed
+    REQUIRE(parser.getData()["a"]["x"] == "9");
+    REQUIRE(parser.getData()["b"]["y"] == "2");
+
+    REQUIRE(parser.update("top=1\n[b]\ny=2\n") == 0); // a section was removed
+    REQUIRE(!parser.getData().hasSection("a"));
+    REQUIRE(parser.getData().getSize() == 2);
+}
+
+TEST_CASE("Binary snapshot", "[binary]")
+{
+    ini::Data d;
+    d[""]["top"] = "1";
+    d["s"]["a"] = "b";
+    d["s"]["c"] = "d";
+
+    const auto snapshot = ini::encodeBinary(d);
+
+    const ini::Data loaded = ini::parseBinary(snapshot.data(), snapshot.data() + snapshot.size());
+    REQUIRE(ini::encode(loaded) == ini::encode(d));
+
+    const ini::DataView view = ini::parseBinaryView(snapshot.data(), snapshot.data() + snapshot.size());
+    REQUIRE(view.getSize() == 2);
+    REQUIRE(view["s"]["a"] == "b");
+    REQUIRE(view[""]["top"] == "1");
+
+    REQUIRE_THROWS_AS(ini::parseBinary(snapshot.data(), snapshot.data() + 3), ini::ParseError);
+
+    const std::string garbage = "not a snapshot";
+    REQUIRE_THROWS_AS(ini::parseBinary(garbage.data(), garbage.data() + garbage.size()), ini::ParseError);
+}
+
+TEST_CASE("Binary snapshot of an empty section", "[binary]")
+{
+    ini::Data d;
+    d["empty"] = ini::Section{};
+
+    const auto snapshot = ini::encodeBinary(d);
+    const ini::Data loaded = ini::parseBinary(snapshot.data(), snapshot.data() + snapshot.size());
+
+    REQUIRE(loaded.hasSection("empty"));
+    REQUIRE(loaded["empty"].getSize() == 0);
+}
+
+TEST_CASE("Typed values", "[values]")
+{
+    ini::Section section;
+    section["int"] = "-42";
+    section["unsigned"] = "42";
+    section["double"] = "1.5";
+    section["flag"] = "true";
+
+    REQUIRE(section.getValue<int>("int") == -42);
+    REQUIRE(section.getValue<std::int64_t>("int") == -42);
+    REQUIRE(section.getValue<unsigned>("unsigned") == 42);
+    REQUIRE(section.getValue<double>("double") == 1.5);
+    REQUIRE(section.getValue<bool>("flag"));
+
+    // a write must invalidate the memoized conversion
+    REQUIRE(section.getValue<int>("int") == -42);
+    section["int"] = "7";
+    REQUIRE(section.getValue<int>("int") == 7);
+
+    REQUIRE_THROWS_AS(section.getValue<int>("missing"), ini::RangeError);
+    REQUIRE_THROWS_AS(section.getValue<int>("flag"), ini::ParseError);
+    REQUIRE_THROWS_AS(section.getValue<bool>("double"), ini::ParseError);
+}
+
+TEST_CASE("Static parsing", "[static]")
+{
+    constexpr auto d = ini::parseStatic<8>("top=1\n[s]\na=b\nc=1\na=d\n;x\n");
+    static_assert(d.getSize() == 3);
+    static_assert(d.getValue("s", "a") == "d");
+    static_assert(d.getValue("s", "c") == "1");
+    static_assert(d.getValue("", "top") == "1");
+    static_assert(d.hasValue("s", "a"));
+    static_assert(!d.hasValue("s", "missing"));
+    static_assert(d.getValue("s", "missing", "fallback") == "fallback");
+
+    REQUIRE(d.getValue("s", "a") == "d");
+    REQUIRE_THROWS_AS(ini::parseStatic<1>("a=1\nb=2\n"), ini::RangeError);
+    REQUIRE_THROWS_AS(ini::parseStatic<8>("[broken\n"), ini::ParseError);
+}
+
+TEST_CASE("Static parsing of re-declared sections", "[static]")
+{
+    // a repeated header resets the section at compile time too, matching the
+    // runtime parser
+    constexpr auto data = ini::parseStatic<8>(std::string_view{"[s]\nx=1\n[t]\nq=0\n[s]\ny=2\n"});
+    static_assert(!data.hasValue("s", "x"));
+    static_assert(data.getValue("s", "y") == "2");
+    static_assert(data.getValue("t", "q") == "0");
+    static_assert(data.getSize() == 2);
+    REQUIRE(data.getValue("s", "y") == "2");
+}
+
+TEST_CASE("Bulk lookup", "[values]")
+{
+    ini::Section section;
+    section["a"] = "1";
+    section["c"] = "2";
+    section["e"] = "3";
+
+    const std::array<std::string_view, 4> keys = {"a", "b", "c", "e"};
+    std::array<std::string_view, 4> results;
+
+    REQUIRE(section.getValues(keys.data(), keys.size(), results.data()) == 3);
+    REQUIRE(results[0] == "1");
+    REQUIRE(results[1].empty());
+    REQUIRE(results[2] == "2");
+    REQUIRE(results[3] == "3");
+
+    // unsorted keys still resolve
+    const std::array<std::string_view, 2> unsorted = {"e", "a"};
+    std::array<std::string_view, 2> unsortedResults;
+    REQUIRE(section.getValues(unsorted.data(), unsorted.size(), unsortedResults.data()) == 2);
+    REQUIRE(unsortedResults[0] == "3");
+    REQUIRE(unsortedResults[1] == "1");
+
+    ini::UnorderedSection unordered;
+    unordered["a"] = "1";
+    std::array<std::string_view, 2> hashResults;
+    REQUIRE(unordered.getValues(keys.data(), 2, hashResults.data()) == 1);
+    REQUIRE(hashResults[0] == "1");
+    REQUIRE(hashResults[1].empty());
+}
+
+TEST_CASE("Streaming encoding", "[encoding]")
+{
+    ini::Data d;
+    d["foo"]["a"] = "a";
+    d[""]["b"] = "c";
+
+    std::string iteratorResult;
+    ini::encode(d, std::back_inserter(iteratorResult));
+    REQUIRE(iteratorResult == ini::encode(d));
+
+    std::ostringstream stream;
+    ini::encode(d, stream);
+    REQUIRE(stream.str() == ini::encode(d));
+}
+
+TEST_CASE("Overlay data", "[overlay]")
+{
+    const auto base = std::make_shared<const ini::Data>(ini::parse("[a]\nx=1\n[b]\ny=2\n"));
+
+    ini::OverlayData first{base};
+    ini::OverlayData second{base};
+
+    // unmodified sections are read straight from the shared base
+    REQUIRE(&std::as_const(first)["a"] == &(*base)["a"]);
+    REQUIRE(std::as_const(first)["a"]["x"] == "1");
+    REQUIRE(first.getSize() == 2);
+
+    // a write materializes a private copy and leaves the siblings alone
+    first["a"]["x"] = "9";
+    REQUIRE(std::as_const(first)["a"]["x"] == "9");
+    REQUIRE(std::as_const(second)["a"]["x"] == "1");
+    REQUIRE((*base)["a"]["x"] == "1");
+    REQUIRE(&std::as_const(second)["a"] == &(*base)["a"]);
+
+    first.eraseSection("b");
+    REQUIRE(!first.hasSection("b"));
+    REQUIRE(second.hasSection("b"));
+    REQUIRE(first.getSize() == 1);
+
+    const ini::Data flattened = first.flatten();
+    REQUIRE(ini::encode(flattened) == "[a]\nx=9\n");
+
+    REQUIRE_THROWS_AS(std::as_const(first)["b"], ini::RangeError);
+}
+
+TEST_CASE("Interned parsing", "[intern]")
+{
+    ini::StringPool pool;
+
+    const std::string first = "[server]\nhost=a\nport=80\n";
+    const std::string second = "[server]\nhost=b\nport=80\n";
+
+    const ini::DataView one = ini::parse(first, pool);
+    const ini::DataView two = ini::parse(second, pool);
+
+    REQUIRE(one["server"]["host"] == "a");
+    REQUIRE(two["server"]["host"] == "b");
+
+    // repeated names, keys and values share one pooled allocation
+    REQUIRE(one["server"].getName().data() == two["server"].getName().data());
+    REQUIRE(one["server"]["port"].data() == two["server"]["port"].data());
+    REQUIRE(pool.getSize() == 6);
+
+    // the views are backed by the pool, not the parsed buffers
+    const auto outside = [&first](const std::string_view view) noexcept {
+        return view.data() < first.data() || view.data() >= first.data() + first.size();
+    };
+    REQUIRE(outside(one["server"]["host"]));
+}
+
+TEST_CASE("Parallel parsing", "[parallel]")
+{
+    std::string input = "top=0\n";
+    for (std::size_t section = 0; section < 400; ++section)
+    {
+        input += "[section" + std::to_string(section) + "]\n";
+        for (std::size_t key = 0; key < 20; ++key)
+            input += "key" + std::to_string(key) + '=' + std::to_string(section * key) + '\n';
+    }
+
+    const ini::Data serial = ini::parse(input);
+    const ini::Data parallel = ini::parseParallel(input, 8);
+
+    REQUIRE(parallel.getSize() == serial.getSize());
+    REQUIRE(ini::encode(parallel) == ini::encode(serial));
+
+    // small buffers and single-thread requests fall back to the serial path
+    const ini::Data single = ini::parseParallel(input, 1);
+    REQUIRE(ini::encode(single) == ini::encode(serial));
+    REQUIRE(ini::encode(ini::parseParallel("[s]\nk=v\n", 8)) == "[s]\nk=v\n");
+}
+
+TEST_CASE("Lazy parsing", "[lazy]")
+{
+    const std::string input = "top=1\n[a]\nx=1\n[ b ]\ny=2\n=bad\n[c]\nz=3\n";
+    const ini::LazyData data = ini::parseLazy(input);
+
+    REQUIRE(data.getSize() == 4);
+    REQUIRE(data.hasSection("a"));
+    REQUIRE(data.hasSection("b"));
+    REQUIRE(!data.hasSection("missing"));
+    REQUIRE(data.getMaterializedCount() == 0);
+
+    // only the touched sections get parsed
+    REQUIRE(data["a"]["x"] == "1");
+    REQUIRE(data[""]["top"] == "1");
+    REQUIRE(data.getMaterializedCount() == 2);
+
+    // a malformed body only surfaces when its section is accessed
+    REQUIRE_THROWS_AS(data["b"], ini::ParseError);
+    REQUIRE(data["c"]["z"] == "3");
+
+    REQUIRE_THROWS_AS(data["missing"], ini::RangeError);
+}
+
+TEST_CASE("Frozen data", "[frozen]")
+{
+    const ini::Data data = ini::parse("top=0\n[b]\nx=1\ny=2\n[a]\nz=3\n");
+    const ini::FrozenData frozen = ini::freeze(data);
+
+    REQUIRE(frozen.getSize() == 3);
+    REQUIRE(frozen.hasSection("a"));
+    REQUIRE(!frozen.hasSection("c"));
+    REQUIRE(frozen["b"]["x"] == "1");
+    REQUIRE(frozen["b"]["y"] == "2");
+    REQUIRE(frozen["a"].getName() == "a");
+    REQUIRE(frozen["a"].getSize() == 1);
+    REQUIRE(frozen[""]["top"] == "0");
+    REQUIRE(frozen["b"].getValue("missing", "fallback") == "fallback");
+    REQUIRE(!frozen["b"].hasValue("missing"));
+
+    REQUIRE_THROWS_AS(frozen["c"], ini::RangeError);
+    REQUIRE_THROWS_AS(frozen["b"]["missing"], ini::RangeError);
+
+    // unordered sources get sorted during the repack
+    ini::UnorderedData unordered;
+    unordered["s"]["d"] = "4";
+    unordered["s"]["b"] = "2";
+    unordered["s"]["c"] = "3";
+    unordered["s"]["a"] = "1";
+    const ini::FrozenData sorted = ini::freeze(unordered);
+    REQUIRE(sorted["s"]["a"] == "1");
+    REQUIRE(sorted["s"]["d"] == "4");
+}
+
+TEST_CASE("Bulk insertion", "[bulk]")
+{
+    const std::array<std::pair<std::string, std::string>, 4> pairs{{
+        {"a", "1"}, {"b", "2"}, {"c", "3"}, {"b", "overwritten"}
+    }};
+
+    ini::Data data;
+    data["s"].insert(pairs.begin(), pairs.end());
+
+    REQUIRE(data["s"].getSize() == 3);
+    REQUIRE(data["s"]["a"] == "1");
+    REQUIRE(data["s"]["b"] == "overwritten");
+    REQUIRE(data["s"]["c"] == "3");
+
+    // the bulk insert drops stale memoized conversions
+    REQUIRE(data["s"].getValue<int>("c") == 3);
+    const std::array<std::pair<std::string, std::string>, 1> update{{{"c", "30"}}};
+    data["s"].insert(update.begin(), update.end());
+    REQUIRE(data["s"].getValue<int>("c") == 30);
+
+    auto cursor = data.makeCursor();
+    for (std::size_t key = 0; key < 10; ++key)
+        cursor["t"]["key" + std::to_string(key)] = std::to_string(key);
+    cursor["u"]["other"] = "1";
+
+    REQUIRE(data["t"].getSize() == 10);
+    REQUIRE(data["t"]["key7"] == "7");
+    REQUIRE(data["u"]["other"] == "1");
+}
+
+TEST_CASE("Non-throwing parsing", "[tryparse]")
+{
+    ini::Data data;
+    ini::ParseResult status;
+
+    REQUIRE(ini::tryParse("[s]\nk=v ;note\n;comment\n", data, status));
+    REQUIRE(static_cast<bool>(status));
+    REQUIRE(data["s"]["k"] == "v");
+
+    ini::Data bad;
+    REQUIRE(!ini::tryParse("k=v\n\n=value\n", bad, status));
+    REQUIRE(status.error == ini::ParseResult::Error::invalidKeyName);
+    REQUIRE(status.offset == 5);
+    REQUIRE(status.line == 3);
+    REQUIRE(std::string{status.getMessage()} == "Invalid key name");
+
+    REQUIRE(!ini::tryParse("[section", bad, status));
+    REQUIRE(status.error == ini::ParseResult::Error::unexpectedEndOfSection);
+
+    REQUIRE(!ini::tryParse("[]\n", bad, status));
+    REQUIRE(status.error == ini::ParseResult::Error::invalidSectionName);
+
+    REQUIRE(!ini::tryParse("[s] junk\n", bad, status));
+    REQUIRE(status.error == ini::ParseResult::Error::unexpectedCharacterAfterSection);
+
+    REQUIRE(!ini::tryParse("k=a=b\n", bad, status));
+    REQUIRE(status.error == ini::ParseResult::Error::unexpectedCharacter);
+
+    // a successful call resets an earlier error
+    REQUIRE(ini::tryParse("k=v\n", data, status));
+    REQUIRE(status.error == ini::ParseResult::Error::none);
+}
+
+TEST_CASE("Merging layers", "[merge]")
+{
+    const ini::Data defaults = ini::parse("[server]\nhost=localhost\nport=80\ntimeout=5\n[log]\nlevel=info\n");
+    const ini::Data region = ini::parse("[server]\nhost=region.example\n[region]\nzone=west\n");
+    const ini::Data tenant = ini::parse("[server]\nport=8080\n[log]\nlevel=debug\n");
+
+    const ini::Data merged = ini::merge({&defaults, &region, &tenant});
+
+    REQUIRE(merged.getSize() == 3);
+    REQUIRE(merged["server"]["host"] == "region.example");
+    REQUIRE(merged["server"]["port"] == "8080");
+    REQUIRE(merged["server"]["timeout"] == "5");
+    REQUIRE(merged["log"]["level"] == "debug");
+    REQUIRE(merged["region"]["zone"] == "west");
+
+    // a single layer merges to itself, no layers merge to nothing
+    REQUIRE(ini::encode(ini::merge({&defaults})) == ini::encode(defaults));
+    REQUIRE(ini::merge({}).getSize() == 0);
+}
+
+TEST_CASE("Parse statistics", "[stats]")
+{
+    const std::string input = ";header\ntop=1\n[a]\nx=12345\ny=2\n[empty]\n[b]\nz=3 ;note\n";
+
+    ini::ParseStats stats;
+    const ini::Data data = ini::parse(input, stats);
+
+    REQUIRE(data["a"]["x"] == "12345");
+    REQUIRE(stats.bytes == input.size());
+    REQUIRE(stats.lines == 8);
+    REQUIRE(stats.sections == 3);
+    REQUIRE(stats.keys == 4);
+    REQUIRE(stats.comments == 2);
+    REQUIRE(stats.emptySections == 1);
+    REQUIRE(stats.maxValueLength == 5);
+
+    // a trailing section with no keys is counted too
+    const ini::Data tail = ini::parse(std::string_view{"[only]\n"}, stats);
+    REQUIRE(tail.hasSection("only"));
+    REQUIRE(stats.emptySections == 1);
+    REQUIRE(stats.lines == 1);
+}
+
+TEST_CASE("Duplicate policies", "[policy]")
+{
+    const std::string bundle = "[s]\na=1\nb=2\n[t]\nx=9\n[s]\na=10\nc=3\n";
+
+    // the default parse resets a re-declared section
+    const ini::Data reset = ini::parse(bundle);
+    REQUIRE(!reset["s"].hasValue("b"));
+
+    const ini::Data overwritten = ini::parse(bundle, ini::DuplicatePolicy::overwrite);
+    REQUIRE(overwritten["s"]["a"] == "10");
+    REQUIRE(overwritten["s"]["b"] == "2");
+    REQUIRE(overwritten["s"]["c"] == "3");
+    REQUIRE(overwritten["t"]["x"] == "9");
+
+    const ini::Data first = ini::parse(bundle, ini::DuplicatePolicy::keepFirst);
+    REQUIRE(first["s"]["a"] == "1");
+    REQUIRE(first["s"]["b"] == "2");
+    REQUIRE(first["s"]["c"] == "3");
+
+    const ini::Data appended = ini::parse(bundle, ini::DuplicatePolicy::append);
+    REQUIRE(appended["s"]["a"] == "1,10");
+    REQUIRE(appended["s"]["b"] == "2");
+
+    // a re-opened section without keys still exists
+    const ini::Data empty = ini::parse(std::string_view{"[s]\n"}, ini::DuplicatePolicy::overwrite);
+    REQUIRE(empty.hasSection("s"));
+}
+
+TEST_CASE("Chunked parsing", "[chunk]")
+{
+    const std::string input = "\xEF\xBB\xBFtop=1\n[a]\nx=1 ;note\ny=2\r\n[b]\nz=3";
+    const ini::Data whole = ini::parse(input);
+
+    // feeding byte by byte splits the byte order mark, section headers and
+    // the carriage return pair across chunk boundaries
+    for (const std::size_t chunkSize : {std::size_t{1}, std::size_t{3}, std::size_t{7}})
+    {
+        ini::ChunkParser parser;
+        for (std::size_t offset = 0; offset < input.size(); offset += chunkSize)
+            parser.feed(std::string_view{input}.substr(offset, chunkSize));
+
+        const ini::Data data = parser.finish();
+        REQUIRE(ini::encode(data) == ini::encode(whole));
+    }
+
+    // the parser is reusable after finish
+    ini::ChunkParser parser;
+    parser.feed("[s]\nk=");
+    parser.feed("v\n");
+    REQUIRE(parser.finish()["s"]["k"] == "v");
+    parser.feed("other=1\n");
+    const ini::Data second = parser.finish();
+    REQUIRE(second[""]["other"] == "1");
+    REQUIRE(!second.hasSection("s"));
+}
+
+TEST_CASE("Pathological inputs", "[pathological]")
+{
+    // distilled from fuzzing: inputs that stress one code path at a time
+    std::string megaValue = "[s]\nkey=";
+    megaValue.append(1024 * 1024, 'x');
+    megaValue += '\n';
+    const ini::Data mega = ini::parse(megaValue);
+    REQUIRE(mega["s"]["key"].size() == 1024 * 1024);
+
+    std::string commentFlood;
+    for (std::size_t line = 0; line < 10000; ++line)
+        commentFlood += ";comment\n";
+    REQUIRE(ini::parse(commentFlood).getSize() == 0);
+
+    const std::string blankFlood(1024 * 1024, '\n');
+    REQUIRE(ini::parse(blankFlood).getSize() == 0);
+
+    std::string sectionFlood;
+    for (std::size_t section = 0; section < 10000; ++section)
+        sectionFlood += "[section" + std::to_string(section) + "]\n";
+    REQUIRE(ini::parse(sectionFlood).getSize() == 10000);
+
+    REQUIRE(ini::parse(std::string{"\xEF\xBB\xBF"}).getSize() == 0);
+}
+
+TEST_CASE("Cached encoding", "[cache]")
+{
+    ini::Data data = ini::parse("[a]\nx=1\n[b]\ny=2\n");
+    ini::EncodeCache cache;
+
+    const std::string& encoded = cache.encode(data);
+    REQUIRE(encoded == ini::encode(data));
+
+    // an unchanged tree returns the retained buffer without re-encoding
+    REQUIRE(cache.encode(data).data() == encoded.data());
+    REQUIRE(cache.encode(data) == encoded);
+
+    // a write bumps the section version and refreshes only that fragment
+    data["a"]["x"] = "10";
+    REQUIRE(cache.encode(data) == "[a]\nx=10\n[b]\ny=2\n");
+    REQUIRE(cache.encode(data) == ini::encode(data));
+
+    data.eraseSection("b");
+    REQUIRE(cache.encode(data) == "[a]\nx=10\n");
+
+    data["c"]["z"] = "3";
+    REQUIRE(cache.encode(data) == ini::encode(data));
+
+    // the byte order mark participates in the cache validity
+    REQUIRE(cache.encode(data, true) == ini::encode(data, true));
+    REQUIRE(cache.encode(data) == ini::encode(data));
+
+    cache.invalidate();
+    REQUIRE(cache.encode(data) == ini::encode(data));
+}
+
+TEST_CASE("Contiguous input routing", "[parsing]")
+{
+    const std::string text = "[s]\nk=v\n";
+
+    // contiguous byte containers take the pointer path, everything else the
+    // generic iterator path; the results must not differ
+    const std::vector<char> contiguous{text.begin(), text.end()};
+    const std::deque<char> scattered{text.begin(), text.end()};
+
+    REQUIRE(ini::encode(ini::parse(text)) == text);
+    REQUIRE(ini::encode(ini::parse(contiguous)) == text);
+    REQUIRE(ini::encode(ini::parse(scattered)) == text);
+}
+
+TEST_CASE("Empty key error identity", "[parsing]")
+{
+    // every entry point must agree that "=a=b" fails on the key, not on the
+    // second equals sign further down the line
+    REQUIRE_THROWS_WITH(ini::parse("=a=b"), "Invalid key name");
+    REQUIRE_THROWS_WITH(ini::parseView("=a=b"), "Invalid key name");
+
+    ini::Data data;
+    ini::ParseResult status;
+    REQUIRE(!ini::tryParse(std::string_view{"=a=b"}, data, status));
+    REQUIRE(status.error == ini::ParseResult::Error::invalidKeyName);
+    REQUIRE(status.offset == 0);
+}
+
+TEST_CASE("Incremental parsing of re-declared sections", "[incremental]")
+{
+    const std::string bundle = "[a]\nx=1\n[b]\ny=2\n[a]\nz=9\n";
+
+    ini::IncrementalParser parser;
+    REQUIRE(parser.update(bundle) == 2);
+
+    // a re-declared section must match a full parse: the last declaration
+    // wins and the earlier one is dropped
+    REQUIRE(ini::encode(parser.getData()) == ini::encode(ini::parse(bundle)));
+    REQUIRE(parser.getData()["a"]["z"] == "9");
+    REQUIRE(!parser.getData()["a"].hasValue("x"));
+
+    // changing only the dead first declaration must not resurrect it
+    const std::string changed = "[a]\nx=CHANGED\n[b]\ny=2\n[a]\nz=9\n";
+    parser.update(changed);
+    REQUIRE(ini::encode(parser.getData()) == ini::encode(ini::parse(changed)));
+    REQUIRE(parser.getData()["a"]["z"] == "9");
+    REQUIRE(!parser.getData()["a"].hasValue("x"));
+
+    // an unchanged bundle rebuilds nothing even with duplicates present
+    REQUIRE(parser.update(changed) == 0);
+}
+
+TEST_CASE("Buffer encoding with plain integer capacities", "[encoding]")
+{
+    const ini::Data data = ini::parse("[s]\nk=v\n");
+
+    // the capacity may be any integer type without colliding with the
+    // output-iterator overload
+    char buffer[64];
+    const auto written = ini::encode(data, buffer, 64);
+    REQUIRE(std::string(buffer, written) == "[s]\nk=v\n");
+    REQUIRE(ini::encode(data, buffer, 64u) == written);
+    REQUIRE(ini::encode(data, buffer, 64L) == written);
+}